@@ -36,6 +36,11 @@
 #include "sequence.hh"
 #include "string.hh"
 #include "table.hh"
+#include "table_profile.hh"
+#include "sparse_table.hh"
+#include "soa_table.hh"
+#include "fixed_table.hh"
+#include "row_table.hh"
 #include "terminal.hh"
 
 #include "filter.hh"
@@ -45,11 +50,14 @@
 #include "output.hh"
 
 #include "push_back.hh"
+#include "split_reduce.hh"
 
 #include "shape.hh"
 
 #include "bigint.hh"
 
+#include "ext_double.hh"
+
 #include "backtrack.hh"
 
 #include "bench.hh"
@@ -26,8 +26,10 @@
 #define RTLIB_ALGEBRA_HH_
 
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <utility>
+#include <vector>
 
 #include "empty.hh"
 
@@ -137,25 +139,45 @@ T expsum(T t) {
   return t;
 }
 
+/*
+   log(sum(exp(x[i]))) over a contiguous array; shifting by the maximum
+   avoids the overflow of exp() for large scores, i.e. for long inputs.
+   Both passes are plain reductions without branches, such that the
+   compiler vectorizes them (with -O3; the exp pass needs -ffast-math
+   or a vector math library).
+*/
+template <typename T>
+inline T log_sum_exp(const T *x, size_t n) {
+  assert(n);
+  T m = x[0];
+  for (size_t i = 1; i < n; ++i)
+    m = x[i] > m ? x[i] : m;
+  // all -inf, i.e. log(0), or a +inf candidate: x[i] - m would be NaN
+  if (std::isinf(m))
+    return m;
+  T s = 0;
+  for (size_t i = 0; i < n; ++i)
+    s += exp(x[i] - m);
+  return m + log(s);
+}
+
 template <typename Itr>
 inline
 typename std::iterator_traits<Itr>::value_type expsum(Itr begin, Itr end) {
-  typename std::iterator_traits<Itr>::value_type n;
+  typedef typename std::iterator_traits<Itr>::value_type type;
+  type n;
   if (begin == end) {
     empty(n);
     return n;
   }
-  assert(!isEmpty(*begin));
-  n = exp(*begin);
-  ++begin;
+  // candidate lists are not necessarily contiguous (e.g. List is a deque)
+  static thread_local std::vector<type> buffer;
+  buffer.clear();
   for (; begin != end; ++begin) {
     assert(!isEmpty(*begin));
-    n += exp(*begin);
+    buffer.push_back(*begin);
   }
-  assert((n > 0 && "Your algebra produces (partial) candidates with negative "
-                   "score, which cannot be logarithmized. Avoid h=expsum or "
-                   "ensure all positive values!"));
-  return log(n);
+  return log_sum_exp(buffer.data(), buffer.size());
 }
 
 template <typename Iterator>
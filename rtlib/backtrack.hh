@@ -24,8 +24,11 @@
 #ifndef RTLIB_BACKTRACK_HH_
 #define RTLIB_BACKTRACK_HH_
 
+#include <algorithm>
 #include <cassert>
+#include <map>
 #include <utility>
+#include <vector>
 
 // FIXME replace with more efficient version
 #include <list>
@@ -33,6 +36,8 @@
 #include <boost/intrusive_ptr.hpp>
 using boost::intrusive_ptr;
 
+#include "output.hh"
+
 template<typename Value>
 class Eval_List {
  private:
@@ -53,7 +58,8 @@ class Eval_List {
       void print(O &out, const T &v) {
         for (typename std::list<Value>::iterator i = list.begin();
              i != list.end(); ++i) {
-          out << "( " << v << " , " << *i << " )\n";
+          out << "( ";
+          gapc::put(out, v) << " , " << *i << " )\n";
         }
       }
 };
@@ -372,8 +378,162 @@ class Backtrace_List_Score
     public Backtrace_Score<score_type, Value, pos_int> {
 };
 
+/*
+   The candidates of a non-terminal cell are computed on the first
+   request of one of its score classes (see backtrack(score)). The
+   proxy function of the cell announces the scores of all fronts it
+   creates beforehand (see expect_score()), such that candidates of
+   scores no front asks for are dropped. How the rest is served depends
+   on the forward answer of the cell:
+    - a single score, e.g. a scalar or co-optimal answer, takes one scan
+    - k-scoring lists, i.e. strictly ordered scores, are served from a
+      frontier queue, a heap of the candidates that is only popped up to
+      the score of the current request, so candidates worse than the
+      requested classes are never ordered
+    - classifying answers (the score classes are unordered) are grouped
+      by score once, keyed by an ordered map
+*/
 template <typename score_type, typename Klass, typename Value, typename pos_int>
 class Backtrace_NT_Back_Base {
+ private:
+    typedef Backtrace_Score<score_type, Value, pos_int> candidate_t;
+    typedef std::vector<intrusive_ptr<candidate_t> > bucket_t;
+
+    enum Mode { NONE, SCAN, ASCENDING, DESCENDING, GROUP };
+    Mode mode;
+
+    // the distinct scores the fronts of the cell request, in the order of
+    // the forward answer
+    std::vector<score_type> keys;
+    // served candidates per key (not in GROUP mode), the first done keys
+    // are complete
+    std::vector<bucket_t> served;
+    size_t done;
+    // not yet served candidates, frontier is a heap of indices into cands
+    // whose top is the next candidate in the order of the keys
+    bucket_t cands;
+    std::vector<size_t> frontier;
+    // GROUP: candidates grouped by score
+    std::map<score_type, bucket_t> groups;
+
+    // true, if score a is served before score b
+    bool before(const score_type &a, const score_type &b) const {
+      return mode == ASCENDING ? a < b : b < a;
+    }
+
+    // heap order, candidates of equal scores are served in candidate order
+    struct later {
+      const Backtrace_NT_Back_Base &b;
+      explicit later(const Backtrace_NT_Back_Base &b) : b(b) {}
+      bool operator()(size_t x, size_t y) const {
+        const score_type &s = b.cands[x]->score();
+        const score_type &t = b.cands[y]->score();
+        if (b.before(t, s))
+          return true;
+        if (b.before(s, t))
+          return false;
+        return x > y;
+      }
+    };
+
+    void prepare() {
+      if (scores == 0)
+        backtrack();
+      for (typename Backtrace_List<Value, pos_int>::iterator i =
+           scores->begin();
+           i != scores->end(); ++i) {
+        intrusive_ptr<candidate_t> bt =
+          boost::dynamic_pointer_cast<candidate_t>(*i);
+        assert(bt != 0);
+        cands.push_back(bt);
+      }
+      scores.reset();
+
+      if (keys.size() == 1) {
+        served.resize(1);
+        mode = SCAN;
+        for (typename bucket_t::iterator i = cands.begin(); i != cands.end();
+             ++i)
+          if ((*i)->score() == keys.front())
+            served.front().push_back(*i);
+        cands.clear();
+        done = 1;
+        return;
+      }
+
+      mode = keys.empty() ? GROUP : ASCENDING;
+      for (size_t i = 1; mode == ASCENDING && i < keys.size(); ++i)
+        if (!(keys[i-1] < keys[i]))
+          mode = DESCENDING;
+      for (size_t i = 1; mode == DESCENDING && i < keys.size(); ++i)
+        if (!(keys[i] < keys[i-1]))
+          mode = GROUP;
+
+      if (mode == GROUP) {
+        // without announced scores, all candidates are kept
+        for (typename std::vector<score_type>::iterator i = keys.begin();
+             i != keys.end(); ++i)
+          groups[*i];
+        for (typename bucket_t::iterator i = cands.begin(); i != cands.end();
+             ++i) {
+          if (keys.empty()) {
+            groups[(*i)->score()].push_back(*i);
+            continue;
+          }
+          typename std::map<score_type, bucket_t>::iterator j =
+            groups.find((*i)->score());
+          if (j != groups.end())
+            j->second.push_back(*i);
+        }
+        cands.clear();
+        return;
+      }
+
+      served.resize(keys.size());
+      frontier.resize(cands.size());
+      for (size_t i = 0; i < frontier.size(); ++i)
+        frontier[i] = i;
+      std::make_heap(frontier.begin(), frontier.end(), later(*this));
+    }
+
+    // pops the frontier until the candidates of keys[k] are complete
+    void advance(size_t k) {
+      while (done <= k) {
+        if (frontier.empty()) {
+          done = keys.size();
+          break;
+        }
+        size_t c = frontier.front();
+        if (before(keys[done], cands[c]->score())) {
+          ++done;
+          continue;
+        }
+        std::pop_heap(frontier.begin(), frontier.end(), later(*this));
+        frontier.pop_back();
+        // candidates before keys[done] are not requested
+        if (cands[c]->score() == keys[done])
+          served[done].push_back(cands[c]);
+        cands[c].reset();
+      }
+      if (frontier.empty())
+        bucket_t().swap(cands);
+    }
+
+    const bucket_t *find(const score_type &score) {
+      if (mode == GROUP) {
+        typename std::map<score_type, bucket_t>::iterator i =
+          groups.find(score);
+        return i == groups.end() ? 0 : &i->second;
+      }
+      typename std::vector<score_type>::iterator i =
+        std::find(keys.begin(), keys.end(), score);
+      if (i == keys.end())
+        return 0;
+      size_t k = i - keys.begin();
+      advance(k);
+      return &served[k];
+    }
+
  protected:
     intrusive_ptr<Backtrace_List<Value, pos_int> > scores;
 
@@ -385,24 +545,27 @@ class Backtrace_NT_Back_Base {
 
  public:
     explicit Backtrace_NT_Back_Base(Klass *klass_)
-      : klass(klass_), count(0) {}
+      : mode(NONE), done(0), klass(klass_), count(0) {}
     virtual ~Backtrace_NT_Back_Base() {}
 
+    // announces the score of a front, before the first backtrack(score)
+    void expect(const score_type &score) {
+      assert(mode == NONE);
+      if (keys.empty() || !(keys.back() == score))
+        keys.push_back(score);
+    }
+
     intrusive_ptr<Backtrace<Value, pos_int> > backtrack(
       const score_type &score) {
       intrusive_ptr<Backtrace_List_Score<score_type, Value, pos_int> > ret;
       ret = new Backtrace_List_Score<score_type, Value, pos_int>();
-      if (scores == 0)
-        backtrack();
-      for (typename Backtrace_List<Value, pos_int>::iterator i =
-           scores->begin();
-           i != scores->end(); ++i) {
-        intrusive_ptr<Backtrace_Score<score_type, Value, pos_int> > bt =
-          boost::dynamic_pointer_cast<
-            Backtrace_Score<score_type, Value, pos_int> >(*i);
-        assert(bt != 0);
-        if (bt->score() == score)
-          ret->push_back(bt);
+      if (mode == NONE)
+        prepare();
+      const bucket_t *b = find(score);
+      if (b) {
+        for (typename bucket_t::const_iterator j = b->begin();
+             j != b->end(); ++j)
+          ret->push_back(*j);
       }
       ret->setScore(score);
       return ret;
@@ -432,6 +595,13 @@ void intrusive_ptr_release(
 }
 
 
+// called by the generated proxy functions for each front of a cell
+template <typename Back, typename score_type>
+inline
+void expect_score(const intrusive_ptr<Back> &back, const score_type &score) {
+  back->expect(score);
+}
+
 template<typename score_type, typename Value, typename pos_int>
 inline
 void
@@ -0,0 +1,120 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+/*
+ * Synchronisation between the cyk loops and the checkpointing thread.
+ * The loops enter the gate shared around the computation of a cell (or
+ * of a tile of cells in OpenMP mode), the archiver locks it exclusively
+ * while it archives the tables and the loop indices, such that it never
+ * sees a half computed cell.
+ *
+ * In contrast to a (fair) mutex, entering and leaving the gate costs one
+ * uncontended atomic add each; the loops only block while an archive is
+ * being written. The archiver raises the pause flag, which keeps new
+ * cells from being entered, and waits until the cells in progress are
+ * left.
+ *
+ * Usable with std::shared_lock (cyk loops) and std::lock_guard
+ * (archiver).
+ */
+
+#ifndef RTLIB_CHECKPOINT_GATE_HH_
+#define RTLIB_CHECKPOINT_GATE_HH_
+
+#include <atomic>
+#include <condition_variable>  // NOLINT [build/c++11]
+#include <cstddef>
+#include <mutex>  // NOLINT [build/c++11]
+#include <shared_mutex>
+
+namespace gapc {
+
+class Checkpoint_Gate {
+ private:
+  // number of cells in progress
+  std::atomic<size_t> active;
+  // true while the archiver holds the gate
+  std::atomic<bool> paused;
+  // serializes archivers
+  std::mutex archiver;
+  // for waiting on the state changes above only
+  std::mutex m;
+  std::condition_variable cv;
+
+  void notify() {
+    std::lock_guard<std::mutex> lk(m);
+    cv.notify_all();
+  }
+
+ public:
+  Checkpoint_Gate() : active(0), paused(false) {
+  }
+
+  Checkpoint_Gate(const Checkpoint_Gate&) = delete;
+  Checkpoint_Gate &operator=(const Checkpoint_Gate&) = delete;
+
+  // cyk loops
+
+  void lock_shared() {
+    for (;;) {
+      active.fetch_add(1);
+      if (!paused.load()) {
+        return;
+      }
+      // back off until the archive is written
+      if (active.fetch_sub(1) == 1) {
+        notify();
+      }
+      std::unique_lock<std::mutex> lk(m);
+      cv.wait(lk, [this] { return !paused.load(); });
+    }
+  }
+
+  void unlock_shared() {
+    if (active.fetch_sub(1) == 1 && paused.load()) {
+      notify();
+    }
+  }
+
+  // archiver
+
+  void lock() {
+    archiver.lock();
+    paused.store(true);
+    std::unique_lock<std::mutex> lk(m);
+    cv.wait(lk, [this] { return active.load() == 0; });
+  }
+
+  void unlock() {
+    {
+      std::lock_guard<std::mutex> lk(m);
+      paused.store(false);
+    }
+    cv.notify_all();
+    archiver.unlock();
+  }
+};
+
+}  // namespace gapc
+
+#endif  // RTLIB_CHECKPOINT_GATE_HH_
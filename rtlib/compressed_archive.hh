@@ -0,0 +1,355 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+/*
+ * Chunked zlib compression of checkpoint archives. The data is cut into
+ * chunks, which are compressed as independent frames by several threads
+ * in parallel; on restore, batches of frames are decompressed in
+ * parallel as well.
+ *
+ * Stream format (native byte order):
+ *   "GAPCZCH1", frames: uint64 raw size, uint64 compressed size, data;
+ *   a frame of raw size 0 ends the stream
+ *
+ * Compressed_Ostream and Compressed_Istream are put between the archive
+ * files and the boost serialization archives. Compressed_Istream passes
+ * uncompressed archives through, i.e. checkpoints that were created
+ * without compression can still be restored.
+ */
+
+#ifndef RTLIB_COMPRESSED_ARCHIVE_HH_
+#define RTLIB_COMPRESSED_ARCHIVE_HH_
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gapc {
+
+namespace zchunk {
+
+static const char MAGIC[8] = {'G', 'A', 'P', 'C', 'Z', 'C', 'H', '1'};
+
+// bytes per frame; large enough for a good ratio, small enough that a
+// batch of one frame per thread stays in memory
+enum { CHUNK = 1 << 22 };
+
+struct Frame {
+  uint64_t raw;
+  std::string data;
+};
+
+// number of threads for threads == 0, i.e. for restoring archives
+inline unsigned threads_or_all(unsigned threads) {
+  if (threads) {
+    return threads;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// calls f(0), ..., f(n-1) from up to threads threads
+template <typename F>
+void parallel_for(size_t n, unsigned threads, F f) {
+  if (threads <= 1 || n <= 1) {
+    for (size_t i = 0; i < n; ++i) {
+      f(i);
+    }
+    return;
+  }
+  std::atomic<size_t> next(0);
+  std::exception_ptr error;
+  std::mutex m;
+  auto work = [&] {
+    for (size_t i; (i = next.fetch_add(1)) < n; ) {
+      try {
+        f(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(m);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+  std::vector<std::thread> pool;
+  for (size_t t = 1; t < std::min<size_t>(threads, n); ++t) {
+    pool.emplace_back(work);
+  }
+  work();
+  for (auto &t : pool) {
+    t.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+inline void compress(const char *data, size_t n, Frame &f) {
+  uLongf len = compressBound(n);
+  f.raw = n;
+  f.data.resize(len);
+  if (compress2(reinterpret_cast<Bytef*>(&f.data[0]), &len,
+                reinterpret_cast<const Bytef*>(data), n, Z_BEST_SPEED)
+      != Z_OK) {
+    throw std::runtime_error("zlib compression failed");
+  }
+  f.data.resize(len);
+}
+
+inline void uncompress(const Frame &f, char *out) {
+  uLongf len = f.raw;
+  if (::uncompress(reinterpret_cast<Bytef*>(out), &len,
+                   reinterpret_cast<const Bytef*>(f.data.data()),
+                   f.data.size()) != Z_OK || len != f.raw) {
+    throw std::runtime_error("corrupt compressed archive");
+  }
+}
+
+inline void put(std::ostream &o, uint64_t x) {
+  o.write(reinterpret_cast<const char*>(&x), sizeof(x));
+}
+
+inline bool get(std::istream &i, uint64_t &x) {
+  return static_cast<bool>(i.read(reinterpret_cast<char*>(&x), sizeof(x)));
+}
+
+/*
+   compresses n bytes in frames of chunk bytes in parallel and writes
+   the frames in order; the end frame is not written
+*/
+inline void write_frames(std::ostream &o, const char *data, size_t n,
+                         size_t chunk, unsigned threads) {
+  std::vector<Frame> frames((n + chunk - 1) / chunk);
+  parallel_for(frames.size(), threads, [&](size_t i) {
+    size_t first = i * chunk;
+    compress(data + first, std::min(chunk, n - first), frames[i]);
+  });
+  for (const Frame &f : frames) {
+    put(o, f.raw);
+    put(o, f.data.size());
+    o.write(f.data.data(), f.data.size());
+  }
+}
+
+inline void write_end(std::ostream &o) {
+  put(o, 0);
+  put(o, 0);
+}
+
+/*
+   reads the next frame; false at the end frame or if the stream is
+   truncated
+*/
+inline bool read_frame(std::istream &in, Frame &f) {
+  uint64_t len;
+  if (!get(in, f.raw) || !get(in, len) || f.raw == 0) {
+    return false;
+  }
+  f.data.resize(len);
+  return len == 0 || static_cast<bool>(in.read(&f.data[0], len));
+}
+
+// decompresses the frames in parallel, one after the other into out
+inline void read_frames(const std::vector<Frame> &frames, char *out,
+                        unsigned threads) {
+  std::vector<size_t> offsets(frames.size() + 1, 0);
+  for (size_t i = 0; i < frames.size(); ++i) {
+    offsets[i + 1] = offsets[i] + frames[i].raw;
+  }
+  parallel_for(frames.size(), threads, [&](size_t i) {
+    uncompress(frames[i], out + offsets[i]);
+  });
+}
+
+}  // namespace zchunk
+
+/*
+   collects one chunk per thread and then compresses and writes them
+   as a batch
+*/
+class Compressed_Ostreambuf : public std::streambuf {
+ private:
+  std::ostream &sink;
+  unsigned threads;
+  std::vector<char> buf;
+  bool finished;
+
+  bool flush_batch() {
+    size_t n = pptr() - pbase();
+    if (n) {
+      zchunk::write_frames(sink, pbase(), n, zchunk::CHUNK, threads);
+    }
+    setp(buf.data(), buf.data() + buf.size());
+    return sink.good();
+  }
+
+ protected:
+  int_type overflow(int_type c) {
+    if (finished || !flush_batch()) {
+      return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  // only flushes the sink, partial batches are kept for the next chunk
+  int sync() {
+    return sink.flush().good() ? 0 : -1;
+  }
+
+ public:
+  Compressed_Ostreambuf(std::ostream &sink, unsigned threads)
+    : sink(sink), threads(threads),
+      buf(static_cast<size_t>(threads) * zchunk::CHUNK), finished(false) {
+    sink.write(zchunk::MAGIC, sizeof(zchunk::MAGIC));
+    setp(buf.data(), buf.data() + buf.size());
+  }
+
+  // writes the remaining data and the end frame
+  bool finish() {
+    if (finished) {
+      return sink.good();
+    }
+    bool ok = flush_batch();
+    zchunk::write_end(sink);
+    finished = true;
+    return ok && sink.flush().good();
+  }
+};
+
+/*
+   reads a batch of one frame per thread and decompresses the frames
+   in parallel
+*/
+class Compressed_Istreambuf : public std::streambuf {
+ private:
+  std::istream &src;
+  unsigned threads;
+  std::vector<zchunk::Frame> frames;
+  std::vector<char> buf;
+  bool done;
+
+ protected:
+  int_type underflow() {
+    if (gptr() < egptr()) {
+      return traits_type::to_int_type(*gptr());
+    }
+    if (done) {
+      return traits_type::eof();
+    }
+    frames.resize(threads);
+    size_t n = 0, bytes = 0;
+    for (; n < threads; ++n) {
+      if (!zchunk::read_frame(src, frames[n])) {
+        if (frames[n].raw != 0 || !src.good()) {
+          throw std::runtime_error("truncated compressed archive");
+        }
+        done = true;
+        break;
+      }
+      bytes += frames[n].raw;
+    }
+    frames.resize(n);
+    buf.resize(bytes);
+    zchunk::read_frames(frames, buf.data(), threads);
+    setg(buf.data(), buf.data(), buf.data() + bytes);
+    if (!bytes) {
+      return traits_type::eof();
+    }
+    return traits_type::to_int_type(*gptr());
+  }
+
+ public:
+  Compressed_Istreambuf(std::istream &src, unsigned threads)
+    : src(src), threads(zchunk::threads_or_all(threads)), done(false) {
+  }
+};
+
+/*
+   output stream to put between an archive file and the boost archive;
+   writes the data unchanged if threads == 0
+*/
+class Compressed_Ostream : public std::ostream {
+ private:
+  std::unique_ptr<Compressed_Ostreambuf> zbuf;
+
+ public:
+  Compressed_Ostream(std::ostream &sink, unsigned threads)
+    : std::ostream(sink.rdbuf()) {
+    if (threads) {
+      zbuf.reset(new Compressed_Ostreambuf(sink, threads));
+      rdbuf(zbuf.get());
+    }
+  }
+
+  // to be called after the boost archive wrote its last data
+  void finish() {
+    if (zbuf ? !zbuf->finish() : !flush().good()) {
+      setstate(std::ios::badbit);
+    }
+  }
+};
+
+/*
+   input stream to put between an archive file and the boost archive;
+   detects compressed archives by their magic number and reads all
+   other archives unchanged
+*/
+class Compressed_Istream : public std::istream {
+ private:
+  std::unique_ptr<Compressed_Istreambuf> zbuf;
+
+ public:
+  Compressed_Istream(std::istream &src, unsigned threads)
+    : std::istream(src.rdbuf()) {
+    char magic[sizeof(zchunk::MAGIC)];
+    if (src.read(magic, sizeof(magic)) &&
+        std::memcmp(magic, zchunk::MAGIC, sizeof(magic)) == 0) {
+      zbuf.reset(new Compressed_Istreambuf(src, threads));
+      rdbuf(zbuf.get());
+    } else {
+      src.clear();
+      src.seekg(0);
+    }
+  }
+};
+
+}  // namespace gapc
+
+#endif  // RTLIB_COMPRESSED_ARCHIVE_HH_
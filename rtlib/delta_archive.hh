@@ -0,0 +1,365 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+/*
+ * Incremental table archives for checkpointing in CYK mode. Instead of
+ * serializing the whole table on every checkpoint, only the blocks of
+ * cells that were written since the last checkpoint are appended to the
+ * archive as raw memory dumps. In CYK mode a cell is written exactly once
+ * with its final value, thus replaying all complete block records of an
+ * archive restores a consistent table, even if the last append was
+ * interrupted.
+ *
+ * File format (native byte order):
+ *   header: "GAPCDLT1", uint64 cell size, uint64 number of cells
+ *   records: uint64 BLOCK, uint64 first cell, uint64 count, cell data
+ *            uint64 ZBLOCK, uint64 first cell, uint64 count,
+ *              cell data as compressed frames (see compressed_archive.hh)
+ *            uint64 COMMIT, uint64 number of tabulated cells
+ *
+ * ZBLOCK records are written instead of BLOCK records if compression
+ * threads are given.
+ *
+ * Only tables of trivially copyable cell types are archived this way,
+ * for all others the functions return false and the boost serialization
+ * based archives are used.
+ */
+
+#ifndef RTLIB_DELTA_ARCHIVE_HH_
+#define RTLIB_DELTA_ARCHIVE_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "compressed_archive.hh"
+
+namespace gapc {
+
+template <typename T>
+struct delta_archivable
+  : std::integral_constant<bool, std::is_trivially_copyable<T>::value &&
+                                 !std::is_same<T, bool>::value> {
+};
+
+/*
+   marks the blocks of 2^BITS cells that were written since the last
+   archive; set() of the generated tables may be called concurrently
+   by the OpenMP cyk loops
+*/
+class Dirty_Blocks {
+ public:
+  enum { BITS = 12 };
+
+ private:
+  std::unique_ptr<std::atomic<unsigned char>[]> flags;
+  size_t n;
+
+ public:
+  Dirty_Blocks() : n(0) {
+  }
+
+  void resize(size_t cells) {
+    n = (cells >> BITS) + 1;
+    flags.reset(new std::atomic<unsigned char>[n]);
+    clear();
+  }
+
+  void mark(size_t off) {
+    flags[off >> BITS].store(1, std::memory_order_relaxed);
+  }
+
+  bool is_dirty(size_t block) const {
+    return flags[block].load(std::memory_order_relaxed);
+  }
+
+  size_t blocks() const {
+    return n;
+  }
+
+  void clear() {
+    for (size_t i = 0; i < n; ++i) {
+      flags[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /*
+     returns and clears the flags; used by the snapshot archiver, whose
+     forked child archives the blocks, while the parent forgets them
+  */
+  std::vector<unsigned char> take() {
+    std::vector<unsigned char> r(n);
+    for (size_t i = 0; i < n; ++i) {
+      r[i] = flags[i].exchange(0, std::memory_order_relaxed);
+    }
+    return r;
+  }
+
+  // re-marks blocks returned by take(), if their archive failed
+  void merge(const std::vector<unsigned char> &r) {
+    for (size_t i = 0; i < n && i < r.size(); ++i) {
+      if (r[i]) {
+        flags[i].store(1, std::memory_order_relaxed);
+      }
+    }
+  }
+};
+
+namespace delta {
+
+static const char MAGIC[8] = {'G', 'A', 'P', 'C', 'D', 'L', 'T', '1'};
+enum { BLOCK = 1, COMMIT = 2, ZBLOCK = 3 };
+
+inline void put(std::ofstream &o, uint64_t x) {
+  o.write(reinterpret_cast<const char*>(&x), sizeof(x));
+}
+
+inline bool get(std::ifstream &i, uint64_t &x) {
+  return static_cast<bool>(i.read(reinterpret_cast<char*>(&x), sizeof(x)));
+}
+
+template <typename T>
+void put_block(std::ofstream &o, const std::vector<T> &array,
+               size_t first, size_t count, unsigned threads) {
+  put(o, threads ? ZBLOCK : BLOCK);
+  put(o, first);
+  put(o, count);
+  const char *data = reinterpret_cast<const char*>(array.data() + first);
+  if (threads) {
+    // whole cells per frame, such that the complete frames of a
+    // truncated record can be restored
+    size_t chunk = std::max<size_t>(1, zchunk::CHUNK / sizeof(T)) * sizeof(T);
+    zchunk::write_frames(o, data, count * sizeof(T), chunk, threads);
+    zchunk::write_end(o);
+  } else {
+    o.write(data, count * sizeof(T));
+  }
+}
+
+/*
+   reads the frames of a ZBLOCK record and decompresses them in parallel
+   into the cells from first on; returns false if the record is
+   truncated, after restoring its complete frames
+*/
+template <typename T>
+bool get_zblock(std::ifstream &in, std::vector<T> &array,
+                uint64_t first, uint64_t count, unsigned threads) {
+  std::vector<zchunk::Frame> frames;
+  uint64_t bytes = 0;
+  bool complete = false;
+  for (;;) {
+    zchunk::Frame f;
+    if (!zchunk::read_frame(in, f)) {
+      complete = f.raw == 0 && in.good();
+      break;
+    }
+    bytes += f.raw;
+    if (f.raw % sizeof(T) || bytes > count * sizeof(T)) {
+      throw std::runtime_error("corrupt compressed table archive");
+    }
+    frames.push_back(std::move(f));
+  }
+  zchunk::read_frames(frames, reinterpret_cast<char*>(array.data() + first),
+                      zchunk::threads_or_all(threads));
+  return complete;
+}
+
+template <typename T>
+uint64_t full_size(const std::vector<T> &array) {
+  return sizeof(MAGIC) + 7 * sizeof(uint64_t) + array.size() * sizeof(T);
+}
+
+}  // namespace delta
+
+/*
+   writes the complete table as one block record, via a temporary file
+   such that a crash cannot corrupt the last archive
+*/
+template <typename T>
+bool compact_delta(const std::string &path, const std::vector<T> &array,
+                   size_t tabulated_vals_counter, unsigned threads = 0) {
+  if constexpr (!delta_archivable<T>::value) {
+    return false;
+  } else {
+    std::string tmp = path + "_new";
+    std::ofstream o(tmp.c_str(), std::ios::binary | std::ios::trunc);
+    if (!o.good()) {
+      throw std::ofstream::failure("");
+    }
+    o.write(delta::MAGIC, sizeof(delta::MAGIC));
+    delta::put(o, sizeof(T));
+    delta::put(o, array.size());
+    delta::put_block(o, array, 0, array.size(), threads);
+    delta::put(o, delta::COMMIT);
+    delta::put(o, tabulated_vals_counter);
+    o.close();
+    if (!o.good() || std::rename(tmp.c_str(), path.c_str()) != 0) {
+      throw std::ofstream::failure("");
+    }
+    return true;
+  }
+}
+
+/*
+   appends the dirty blocks to the archive at path; the archive is
+   compacted instead, if it doesn't exist yet or if the appended records
+   have grown it to twice the size of the table;
+   the records are compressed by threads threads, if threads > 0
+*/
+template <typename T>
+bool append_delta(const std::string &path, const std::vector<T> &array,
+                  Dirty_Blocks &dirty, size_t tabulated_vals_counter,
+                  unsigned threads = 0) {
+  if constexpr (!delta_archivable<T>::value) {
+    return false;
+  } else {
+    std::ifstream probe(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!probe.good() ||
+        static_cast<uint64_t>(probe.tellg()) > 2 * delta::full_size(array)) {
+      probe.close();
+      compact_delta(path, array, tabulated_vals_counter, threads);
+      dirty.clear();
+      return true;
+    }
+    probe.close();
+
+    std::ofstream o(path.c_str(), std::ios::binary | std::ios::app);
+    if (!o.good()) {
+      throw std::ofstream::failure("");
+    }
+    size_t cells = array.size();
+    for (size_t b = 0; b < dirty.blocks(); ) {
+      if (!dirty.is_dirty(b)) {
+        ++b;
+        continue;
+      }
+      size_t e = b + 1;
+      while (e < dirty.blocks() && dirty.is_dirty(e)) {
+        ++e;
+      }
+      size_t first = b << Dirty_Blocks::BITS;
+      size_t last = std::min(cells, e << Dirty_Blocks::BITS);
+      if (first < last) {
+        delta::put_block(o, array, first, last - first, threads);
+      }
+      b = e;
+    }
+    delta::put(o, delta::COMMIT);
+    delta::put(o, tabulated_vals_counter);
+    o.close();
+    if (!o.good()) {
+      throw std::ofstream::failure("");
+    }
+    dirty.clear();
+    return true;
+  }
+}
+
+/*
+   replays all complete records of the archive at path into array;
+   returns false if the archive is not a delta archive; compressed
+   records are decompressed by threads threads (0: all cores)
+*/
+template <typename T>
+bool load_delta(const std::string &path, std::vector<T> &array,
+                size_t &tabulated_vals_counter, unsigned threads = 0) {
+  if constexpr (!delta_archivable<T>::value) {
+    return false;
+  } else {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in.good()) {
+      throw std::ifstream::failure("");
+    }
+    char magic[sizeof(delta::MAGIC)];
+    if (!in.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, delta::MAGIC, sizeof(magic)) != 0) {
+      return false;
+    }
+    uint64_t cell_size = 0, cells = 0;
+    if (!delta::get(in, cell_size) || !delta::get(in, cells) ||
+        cell_size != sizeof(T)) {
+      throw std::runtime_error("incompatible table archive " + path);
+    }
+    array.resize(cells);
+    std::vector<T> buf(size_t(1) << Dirty_Blocks::BITS);
+    uint64_t tag;
+    while (delta::get(in, tag)) {
+      if (tag == delta::BLOCK) {
+        uint64_t first, count;
+        if (!delta::get(in, first) || !delta::get(in, count)) {
+          break;
+        }
+        if (first + count > cells) {
+          throw std::runtime_error("corrupt table archive " + path);
+        }
+        // an interrupted append leaves a truncated last record, of which
+        // only the complete cells are restored
+        bool truncated = false;
+        for (uint64_t done = 0; done < count && !truncated; ) {
+          size_t k = std::min<uint64_t>(count - done, buf.size());
+          in.read(reinterpret_cast<char*>(buf.data()), k * sizeof(T));
+          size_t got = static_cast<size_t>(in.gcount()) / sizeof(T);
+          std::memcpy(array.data() + first + done, buf.data(),
+                      got * sizeof(T));
+          done += got;
+          truncated = got < k;
+        }
+        if (truncated) {
+          break;
+        }
+      } else if (tag == delta::ZBLOCK) {
+        uint64_t first, count;
+        if (!delta::get(in, first) || !delta::get(in, count)) {
+          break;
+        }
+        if (first + count > cells) {
+          throw std::runtime_error("corrupt table archive " + path);
+        }
+        if (!delta::get_zblock(in, array, first, count, threads)) {
+          break;
+        }
+      } else if (tag == delta::COMMIT) {
+        uint64_t c;
+        if (!delta::get(in, c)) {
+          break;
+        }
+        tabulated_vals_counter = c;
+      } else {
+        throw std::runtime_error("corrupt table archive " + path);
+      }
+    }
+    return true;
+  }
+}
+
+}  // namespace gapc
+
+#endif  // RTLIB_DELTA_ARCHIVE_HH_
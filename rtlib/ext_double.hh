@@ -0,0 +1,278 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+/*
+ * ExtDouble is a floating point number with a double mantissa and a separate
+ * 64 bit binary exponent. It can be used as answer type of partition function
+ * algebras (declare it via "type ExtDouble = extern" in the gap program),
+ * where products of many Boltzmann weights would under- or overflow a plain
+ * double on long inputs. The value range is practically unbounded, thus
+ * no scale(subword_size) factors are needed.
+ */
+
+#ifndef RTLIB_EXT_DOUBLE_HH_
+#define RTLIB_EXT_DOUBLE_HH_
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <utility>
+
+class ExtDouble {
+#ifdef CHECKPOINTING_INTEGRATED
+  friend class boost::serialization::access;
+
+  template <class Archive>
+  void serialize(Archive &ar, const unsigned int version) {
+    ar & m;
+    ar & e;
+  }
+#endif
+
+ private:
+  // mantissa, either 0, non-finite or 0.5 <= |m| < 1
+  double m;
+  // binary exponent, i.e. value = m * 2^e
+  int64_t e;
+
+  // shifts exponent bits of the mantissa into e
+  void normalize() {
+    if (m == 0) {
+      e = 0;
+      return;
+    }
+    if (!std::isfinite(m)) {
+      return;
+    }
+    int x;
+    m = std::frexp(m, &x);
+    e += x;
+  }
+
+  // difference of binary exponents beyond which the smaller summand
+  // cannot change the 53 bit mantissa of the bigger one
+  enum { MAX_SHIFT = std::numeric_limits<double>::digits + 2 };
+
+  void add(double om, int64_t oe) {
+    if (om == 0) {
+      return;
+    }
+    if (m == 0 || !std::isfinite(om)) {
+      m = om;
+      e = oe;
+      return;
+    }
+    if (!std::isfinite(m)) {
+      return;
+    }
+    if (oe > e) {
+      std::swap(m, om);
+      std::swap(e, oe);
+    }
+    if (e - oe < MAX_SHIFT) {
+      m += std::ldexp(om, static_cast<int>(oe - e));
+    }
+    normalize();
+  }
+
+ public:
+  ExtDouble() : m(0), e(0) {
+  }
+
+  // implicit, such that algebra functions can mix double constants and
+  // librna energy/Boltzmann functions with ExtDouble values
+  ExtDouble(double d) : m(d), e(0) {  // NOLINT [runtime/explicit]
+    normalize();
+  }
+
+  ExtDouble(double mantissa, int64_t exponent) : m(mantissa), e(exponent) {
+    normalize();
+  }
+
+  double mantissa() const {
+    return m;
+  }
+
+  int64_t exponent() const {
+    return e;
+  }
+
+  /* converts back to double; saturates to 0 or +-inf if the value is
+     outside of the double range */
+  double to_double() const {
+    if (m == 0 || !std::isfinite(m)) {
+      return m;
+    }
+    if (e > std::numeric_limits<double>::max_exponent) {
+      return m * std::numeric_limits<double>::infinity();
+    }
+    if (e < std::numeric_limits<double>::min_exponent -
+        std::numeric_limits<double>::digits) {
+      return m * 0.0;
+    }
+    return std::ldexp(m, static_cast<int>(e));
+  }
+
+  explicit operator double() const {
+    return to_double();
+  }
+
+  // natural logarithm of the value, which is always representable
+  double log() const {
+    assert(m > 0);
+    return std::log(m) + static_cast<double>(e) * M_LN2;
+  }
+
+  ExtDouble &operator+=(const ExtDouble &o) {
+    add(o.m, o.e);
+    return *this;
+  }
+
+  ExtDouble &operator-=(const ExtDouble &o) {
+    add(-o.m, o.e);
+    return *this;
+  }
+
+  ExtDouble &operator*=(const ExtDouble &o) {
+    m *= o.m;
+    e += o.e;
+    normalize();
+    return *this;
+  }
+
+  ExtDouble &operator/=(const ExtDouble &o) {
+    m /= o.m;
+    e -= o.e;
+    normalize();
+    return *this;
+  }
+
+  ExtDouble operator-() const {
+    ExtDouble r(*this);
+    r.m = -r.m;
+    return r;
+  }
+
+  /* three way comparison: < 0 if this < o, 0 if equal and > 0 otherwise;
+     both mantissas are normalized, thus for equal signs the exponent
+     decides before the mantissa does */
+  int compare(const ExtDouble &o) const {
+    if (!std::isfinite(m) || !std::isfinite(o.m) || m == 0 || o.m == 0 ||
+        (m < 0) != (o.m < 0)) {
+      return m < o.m ? -1 : (o.m < m ? 1 : 0);
+    }
+    if (e != o.e) {
+      return (e < o.e) != (m < 0) ? -1 : 1;
+    }
+    return m < o.m ? -1 : (o.m < m ? 1 : 0);
+  }
+};
+
+inline ExtDouble operator+(ExtDouble a, const ExtDouble &b) {
+  return a += b;
+}
+
+inline ExtDouble operator-(ExtDouble a, const ExtDouble &b) {
+  return a -= b;
+}
+
+inline ExtDouble operator*(ExtDouble a, const ExtDouble &b) {
+  return a *= b;
+}
+
+inline ExtDouble operator/(ExtDouble a, const ExtDouble &b) {
+  return a /= b;
+}
+
+inline bool operator==(const ExtDouble &a, const ExtDouble &b) {
+  return a.compare(b) == 0;
+}
+
+inline bool operator!=(const ExtDouble &a, const ExtDouble &b) {
+  return a.compare(b) != 0;
+}
+
+inline bool operator<(const ExtDouble &a, const ExtDouble &b) {
+  return a.compare(b) < 0;
+}
+
+inline bool operator>(const ExtDouble &a, const ExtDouble &b) {
+  return a.compare(b) > 0;
+}
+
+inline bool operator<=(const ExtDouble &a, const ExtDouble &b) {
+  return a.compare(b) <= 0;
+}
+
+inline bool operator>=(const ExtDouble &a, const ExtDouble &b) {
+  return a.compare(b) >= 0;
+}
+
+inline double log(const ExtDouble &x) {
+  return x.log();
+}
+
+/*
+   e^x as ExtDouble, does not overflow for large |x|, e.g. to compute
+   Boltzmann weights of complete structures of long sequences
+*/
+inline ExtDouble ext_exp(double x) {
+  double b = x * M_LOG2E;
+  double k = std::floor(b);
+  return ExtDouble(std::exp2(b - k), static_cast<int64_t>(k));
+}
+
+inline void empty(ExtDouble &x) {
+  x = ExtDouble(std::numeric_limits<double>::infinity());
+}
+
+inline bool isEmpty(const ExtDouble &x) {
+  return x.mantissa() == std::numeric_limits<double>::infinity();
+}
+
+/*
+   prints in decimal scientific notation, since the exponent might exceed
+   the range of double
+*/
+inline std::ostream &operator<<(std::ostream &o, const ExtDouble &x) {
+  if (x.mantissa() == 0 || !std::isfinite(x.mantissa())) {
+    o << x.mantissa();
+    return o;
+  }
+  double l = std::log10(std::fabs(x.mantissa())) +
+    static_cast<double>(x.exponent()) * M_LN2 / M_LN10;
+  double k = std::floor(l);
+  double d = std::pow(10.0, l - k);
+  if (x.mantissa() < 0) {
+    d = -d;
+  }
+  std::ios_base::fmtflags flags = o.flags();
+  o << std::fixed << d << 'e' << (k < 0 ? '-' : '+')
+    << static_cast<int64_t>(std::fabs(k));
+  o.flags(flags);
+  return o;
+}
+
+#endif  // RTLIB_EXT_DOUBLE_HH_
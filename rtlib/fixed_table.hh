@@ -0,0 +1,120 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+/*
+ * Storage for the cells of generated tables of programs that are compiled
+ * for short inputs (gapc --fixed-size N). Up to CAP cells, i.e. the table
+ * size for inputs of length N, are kept in an array inside the table
+ * object, thus computing a table of such an input doesn't allocate from
+ * the heap. Longer inputs fall back to a std::vector. The generated main
+ * allocates the object of the generated class once on the heap, thus
+ * the arrays don't count against the stack size.
+ */
+
+#ifndef RTLIB_FIXED_TABLE_HH_
+#define RTLIB_FIXED_TABLE_HH_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace Table {
+
+template <typename T, size_t CAP>
+class Fixed {
+ private:
+  std::array<T, CAP> fixed;
+  std::vector<T> heap;
+  T *cells;
+  size_t n;
+
+  void select() {
+    cells = heap.empty() ? fixed.data() : heap.data();
+  }
+
+ public:
+  typedef T value_type;
+
+  Fixed() : n(0) {
+    select();
+  }
+
+  Fixed(const Fixed &o) : fixed(o.fixed), heap(o.heap), n(o.n) {
+    select();
+  }
+
+  Fixed &operator=(const Fixed &o) {
+    fixed = o.fixed;
+    heap = o.heap;
+    n = o.n;
+    select();
+    return *this;
+  }
+
+  // as std::vector::resize, i.e. new cells are value initialized
+  void resize(size_t k) {
+    if (k > CAP) {
+      if (heap.empty()) {
+        heap.assign(fixed.begin(), fixed.begin() + n);
+      }
+      heap.resize(k);
+    } else {
+      if (!heap.empty()) {
+        for (size_t i = 0; i < k && i < n; ++i) {
+          fixed[i] = heap[i];
+        }
+        std::vector<T>().swap(heap);
+      }
+      for (size_t i = n; i < k; ++i) {
+        fixed[i] = T();
+      }
+    }
+    n = k;
+    select();
+  }
+
+  void clear() {
+    resize(0);
+  }
+
+  size_t size() const {
+    return n;
+  }
+
+  // true, if the cells are stored inside of the table object
+  bool is_fixed() const {
+    return heap.empty();
+  }
+
+  T &operator[](size_t k) {
+    return cells[k];
+  }
+
+  const T &operator[](size_t k) const {
+    return cells[k];
+  }
+};
+
+}  // namespace Table
+
+#endif  // RTLIB_FIXED_TABLE_HH_
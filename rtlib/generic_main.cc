@@ -26,16 +26,22 @@
 
 #include <iostream>
 #include <cassert>
+#include <memory>
 #ifdef FLOAT_ACC
   #include <iomanip>
   #include <limits>
 #endif
+#ifdef TABLE_PROFILE
+  #include <fstream>
+#endif
 
 #include "rtlib/string.hh"
 #include "rtlib/list.hh"
 #include "rtlib/hash.hh"
 #include "rtlib/asymptotics.hh"
 #include "rtlib/generic_opts.hh"
+#include "rtlib/parallel_backtrace.hh"
+#include "rtlib/out_buffer.hh"
 
 int main(int argc, char **argv) {
   gapc::Opts opts;
@@ -45,7 +51,10 @@ int main(int argc, char **argv) {
     std::cerr << "Exception: " << e.what() << '\n';
     std::exit(1);
   }
-  gapc::class_name obj;
+  // on the heap, since the tables of --fixed-size programs are members
+  // of the class, which might exceed the stack
+  std::unique_ptr<gapc::class_name> obj_storage(new gapc::class_name());
+  gapc::class_name &obj = *obj_storage;
 
   try {
     obj.init(opts);
@@ -67,6 +76,17 @@ int main(int argc, char **argv) {
 #endif
   std::cin.tie(0);
 
+  // written by write(2) (or gzip compressed) from a large buffer at the
+  // end of main, thus error exits after this point return from main
+  std::unique_ptr<gapc::Out_Redirect> out_redirect;
+  try {
+    out_redirect.reset(
+      new gapc::Out_Redirect(std::cout, STDOUT_FILENO, opts.gzip_output));
+  } catch (std::exception &e) {
+    std::cerr << "Exception: " << e.what() << '\n';
+    std::exit(1);
+  }
+
 #ifdef FLOAT_ACC
   std::cout << std::setprecision(FLOAT_ACC) << std::fixed;
 #endif
@@ -79,8 +99,11 @@ int main(int argc, char **argv) {
     std::cout << "Answer ("
       << i << ", " << right << ") :\n";
     obj.print_result(std::cout, res);
-    for (unsigned int j = 0; j < opts.repeats; ++j)
-      obj.print_backtrack(std::cout, res);
+    gapc::parallel_backtrace(std::cout, opts.repeats, opts.backtrace_jobs,
+      [&obj, &res](std::ostream &out, unsigned repeats) {
+        for (unsigned int j = 0; j < repeats; ++j)
+          obj.print_backtrack(out, res);
+      });
     if (i+opts.window_size >= n)
       break;
     obj.window_increment();
@@ -92,6 +115,13 @@ int main(int argc, char **argv) {
   gapc::return_type res = obj.run();
 
   gapc::add_event("end_computation");
+#ifdef TABLE_PROFILE
+  {
+    std::ofstream profile(gapc::table_profile_file());
+    profile << "# gapc table profile\n";
+    obj.print_table_profile(profile);
+  }
+#endif
 
 #ifndef OUTSIDE
   std::cout << "Answer: \n";
@@ -105,8 +135,11 @@ int main(int argc, char **argv) {
 #ifdef TRACE
   std::cerr << "start backtrack\n";
 #endif
-  for (unsigned int i = 0; i < opts.repeats; ++i)
-    obj.print_backtrack(std::cout, res);
+  gapc::parallel_backtrace(std::cout, opts.repeats, opts.backtrace_jobs,
+    [&obj, &res](std::ostream &out, unsigned repeats) {
+      for (unsigned int i = 0; i < repeats; ++i)
+        obj.print_backtrack(out, res);
+    });
   obj.print_subopt(std::cout, opts.delta);
 
   gapc::add_event("end");
@@ -27,12 +27,16 @@
 extern "C" {
   #include <getopt.h>
   #include <unistd.h>
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
   #include <ctype.h>
   #include <stdio.h>
 }
 
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <fstream>
 #include <sstream>
 #include <cstring>
@@ -103,13 +107,23 @@ class Opts {
  public:
     typedef std::vector<std::pair<const char*, unsigned> > inputs_t;
     inputs_t inputs;
+    // inputs given by -b, i.e. memory mapped raw binary values
+    std::vector<bool> binary_inputs;
     bool window_mode;
     unsigned int window_size;
     unsigned int window_increment;
+    // -a: maximal index difference between the tracks of banded programs
+    unsigned int band;
+    // -R: rows per block of the tables of linear space programs, 0: about
+    // the square root of the number of rows
+    size_t row_block;
 
     unsigned int delta;
     unsigned int repeats;
     unsigned k;
+    unsigned backtrace_jobs;
+    // -z: gzip compress the output, if built with GZIP_OUTPUT
+    bool gzip_output;
 
 #ifdef CHECKPOINTING_INTEGRATED
     size_t checkpoint_interval;  // default interval: 3600s (1h)
@@ -117,6 +131,8 @@ class Opts {
     boost::filesystem::path  checkpoint_in_path;  // default: empty
     std::string user_file_prefix;
     bool keep_archives;  // default: delete after calculations completed
+    bool snapshot_archives;  // default: archive from the archiving thread
+    unsigned compress_threads;  // default: 0, i.e. uncompressed archives
 #endif
     unsigned int tile_size;
     int argc;
@@ -131,23 +147,74 @@ class Opts {
 #endif
       window_size(0),
       window_increment(0),
+      band(std::numeric_limits<unsigned int>::max()),
+      row_block(0),
       delta(0),
       repeats(1),
       k(3),
+      backtrace_jobs(1),
+      gzip_output(false),
 #ifdef CHECKPOINTING_INTEGRATED
       checkpoint_interval(DEFAULT_CHECKPOINT_INTERVAL),
       checkpoint_out_path(boost::filesystem::current_path()),
       checkpoint_in_path(boost::filesystem::path("")),
       user_file_prefix(""),
       keep_archives(false),
+      snapshot_archives(false),
+      compress_threads(0),
 #endif
       tile_size(32),
       argc(0),
       argv(0) {}
 
     ~Opts() {
-      for (inputs_t::iterator i = inputs.begin(); i != inputs.end(); ++i)
-        delete[] (*i).first;
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        if (binary_input(i) && inputs[i].second)
+          munmap(const_cast<char*>(inputs[i].first), inputs[i].second);
+        else
+          delete[] inputs[i].first;
+      }
+    }
+
+    bool binary_input(size_t track) const {
+      return track < binary_inputs.size() && binary_inputs[track];
+    }
+
+    /*
+       maps the file read-only, it is copied into the sequence without
+       parsing; the values are stored in little endian byte order with
+       the size of the sequence type, i.e. int32, float32 or float64
+    */
+    void map_binary_input(const char *path) {
+      int fd = open(path, O_RDONLY);
+      if (fd < 0)
+        throw OptException(std::string("Cannot open binary input ") + path);
+      struct stat st;
+      if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw OptException(std::string("Cannot stat binary input ") + path);
+      }
+      size_t size = st.st_size;
+      if (size > std::numeric_limits<unsigned>::max()) {
+        close(fd);
+        throw OptException(std::string("Binary input too large: ") + path);
+      }
+      char *m = 0;
+      if (size) {
+        void *p = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+          close(fd);
+          throw OptException(std::string("Cannot map binary input ") + path);
+        }
+        posix_madvise(p, size, POSIX_MADV_SEQUENTIAL);
+        m = static_cast<char*>(p);
+      } else {
+        m = new char[1];
+      }
+      close(fd);
+      inputs.push_back(std::make_pair(m, static_cast<unsigned>(size)));
+      binary_inputs.resize(inputs.size());
+      binary_inputs.back() = true;
     }
 
     void help(char **argv) {
@@ -158,8 +225,47 @@ class Opts {
 #ifdef LIBRNA_RNALIB_H_
         << " (-[tT] [0-9]+)? (-P PARAM-file)?"
 #endif
-        << " (-[drk] [0-9]+)* (-h)? (INPUT|-f INPUT-file)\n"
+#ifdef BANDED
+        << " (-a [0-9]+)?"
+#endif
+#ifdef LINEAR_SPACE
+        << " (-R [0-9]+)?"
+#endif
+#ifdef GZIP_OUTPUT
+        << " (-z)?"
+#endif
+        << " (-[drk] [0-9]+)* (-h)? (INPUT|-f INPUT-file|-b BINARY-file)\n"
         << "--help   ,-h                          print this help message\n"
+        << "--binaryInput,-b         FILE         read an input from FILE as "
+        << "raw little\n"
+        << "                                      endian int32, float32 or "
+        << "float64 values\n"
+        << "                                      (as the sequence type), "
+        << "repeatable\n"
+        << "--backtraceJobs,-J       N            distribute the -r repeated "
+        << "backtraces\n"
+        << "                                      over N forked processes "
+        << "(default: 1)\n"
+#ifdef BANDED
+        << "--band,-a                N            only compute the cells whose "
+        << "indices\n"
+        << "                                      differ by at most N between "
+        << "the tracks\n"
+        << "                                      (default: no limit)\n"
+#endif
+#ifdef LINEAR_SPACE
+        << "--rowBlock,-R            N            keep the table rows in "
+        << "blocks of N rows,\n"
+        << "                                      of which the backtrace "
+        << "recomputes\n"
+        << "                                      evicted ones (default: "
+        << "square root\n"
+        << "                                      of the number of rows)\n"
+#endif
+#ifdef GZIP_OUTPUT
+        << "--gzipOutput,-z                       write the output gzip "
+        << "compressed\n"
+#endif
 #ifdef CHECKPOINTING_INTEGRATED
         << "--checkpointInterval,-p  d:h:m:s      specify the periodic "
         << "checkpointing\n"
@@ -199,6 +305,18 @@ class Opts {
         << "archives\n"
         << "                                      after the program finished "
         << "its calculations\n"
+        << "--snapshotArchives,-S                 write the archives from a "
+        << "forked copy\n"
+        << "                                      of the process, such that "
+        << "the\n"
+        << "                                      calculations don't pause "
+        << "while\n"
+        << "                                      the tables are archived\n"
+        << "--compressArchives,-Z    N            compress the table archives"
+        << "\n"
+        << "                                      with N threads (archives are"
+        << "\n"
+        << "                                      decompressed automatically)\n"
 #endif
 #ifdef _OPENMP
         << "--tileSize,-L            N            set tile size in "
@@ -216,13 +334,21 @@ class Opts {
     void parse(int argc, char **argv) {
       int o = 0;
       char *input = 0;
+      bool binary = false;
       const option long_opts[] = {
             {"help", no_argument, nullptr, 'h'},
             {"checkpointInterval", required_argument, nullptr, 'p'},
             {"checkpointOutput", required_argument, nullptr, 'O'},
             {"checkpointInput", required_argument, nullptr, 'I'},
             {"keepArchives", no_argument, nullptr, 'K'},
+            {"snapshotArchives", no_argument, nullptr, 'S'},
+            {"compressArchives", required_argument, nullptr, 'Z'},
             {"tileSize", required_argument, nullptr, 'L'},
+            {"backtraceJobs", required_argument, nullptr, 'J'},
+            {"binaryInput", required_argument, nullptr, 'b'},
+            {"band", required_argument, nullptr, 'a'},
+            {"rowBlock", required_argument, nullptr, 'R'},
+            {"gzipOutput", no_argument, nullptr, 'z'},
             {nullptr, no_argument, nullptr, 0}};
       this->argc = argc;
       this->argv = argv;
@@ -237,13 +363,22 @@ class Opts {
 #ifdef LIBRNA_RNALIB_H_
               "t:T:P:"
 #endif
+#ifdef BANDED
+              "a:"
+#endif
+#ifdef LINEAR_SPACE
+              "R:"
+#endif
+#ifdef GZIP_OUTPUT
+              "z"
+#endif
 #ifdef CHECKPOINTING_INTEGRATED
-              "p:I:KO:"
+              "p:I:KSO:Z:"
 #endif
 #ifdef _OPENMP
              "L:"
 #endif
-             "hd:r:k:H:", long_opts, nullptr)) != -1) {
+             "hd:r:k:H:J:b:", long_opts, nullptr)) != -1) {
         switch (o) {
           case 'f' :
             {
@@ -276,12 +411,25 @@ class Opts {
             delete[] input;
             }
             break;
+          case 'b' :
+            map_binary_input(optarg);
+            binary = true;
+            break;
           case 'w' :
             window_size = std::atoi(optarg);
             break;
           case 'i' :
             window_increment = std::atoi(optarg);
             break;
+          case 'a' :
+            band = std::strtoul(optarg, 0, 10);
+            break;
+          case 'R' :
+            row_block = std::strtoul(optarg, 0, 10);
+            break;
+          case 'z' :
+            gzip_output = true;
+            break;
 #ifdef LIBRNA_RNALIB_H_
           case 'T' :
           case 't' :
@@ -304,6 +452,11 @@ class Opts {
           case 'r' :
             repeats = std::atoi(optarg);
             break;
+          case 'J' :
+            backtrace_jobs = std::atoi(optarg);
+            if (!backtrace_jobs)
+              throw OptException("number of backtrace jobs (-J) is zero");
+            break;
 #ifdef CHECKPOINTING_INTEGRATED
           case 'p' :
             checkpoint_interval = parse_checkpointing_interval(optarg);
@@ -366,6 +519,12 @@ class Opts {
           case 'K' :
             keep_archives = true;
             break;
+          case 'S' :
+            snapshot_archives = true;
+            break;
+          case 'Z' :
+            compress_threads = std::atoi(optarg);
+            break;
 #endif
 #ifdef _OPENMP
           case 'L' :
@@ -387,7 +546,7 @@ class Opts {
             }
         }
       }
-      if (!input) {
+      if (!input && !binary) {
         if (optind == argc)
           throw OptException("Missing input sequence or no -f.");
         for (; optind < argc; ++optind) {
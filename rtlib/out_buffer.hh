@@ -0,0 +1,217 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+/*
+ * Output buffer of the generated programs, which replaces the buffer of
+ * std::cout. The results, backtraces and inside/outside reports are
+ * collected in a large user space buffer, which is written with write(2)
+ * directly to the file descriptor, i.e. without the stdio layer.
+ * Programs compiled with GZIP_OUTPUT (make GZIP_OUTPUT=1, links zlib)
+ * write a gzip stream instead, if the runtime option -z is given.
+ */
+
+#ifndef RTLIB_OUT_BUFFER_HH_
+#define RTLIB_OUT_BUFFER_HH_
+
+extern "C" {
+#include <unistd.h>
+}
+
+#ifdef GZIP_OUTPUT
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <vector>
+
+namespace gapc {
+
+class Out_Buffer : public std::streambuf {
+ public:
+  enum { SIZE = 1 << 20 };
+
+ private:
+  int fd;
+  std::vector<char> buffer;
+  bool failed;
+  bool finished;
+#ifdef GZIP_OUTPUT
+  bool gzip;
+  z_stream z;
+  std::vector<char> zbuffer;
+#endif
+
+  bool write_all(const char *p, size_t n) {
+    while (n) {
+      ssize_t r = write(fd, p, n);
+      if (r < 0) {
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      p += r;
+      n -= r;
+    }
+    return true;
+  }
+
+#ifdef GZIP_OUTPUT
+  bool deflate_all(const char *p, size_t n, int flush) {
+    z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(p));
+    z.avail_in = n;
+    do {
+      z.next_out = reinterpret_cast<Bytef*>(zbuffer.data());
+      z.avail_out = zbuffer.size();
+      if (deflate(&z, flush) == Z_STREAM_ERROR)
+        return false;
+      if (!write_all(zbuffer.data(), zbuffer.size() - z.avail_out))
+        return false;
+    } while (z.avail_out == 0);
+    return true;
+  }
+#endif
+
+  // writes n bytes, which are not buffered
+  bool emit(const char *p, size_t n, bool flush) {
+    if (failed || finished)
+      return false;
+#ifdef GZIP_OUTPUT
+    if (gzip) {
+      failed = !deflate_all(p, n, flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+      return !failed;
+    }
+#endif
+    failed = !write_all(p, n);
+    return !failed;
+  }
+
+  bool drain(bool flush) {
+    size_t n = pptr() - pbase();
+    setp(buffer.data(), buffer.data() + buffer.size());
+    return emit(buffer.data(), n, flush);
+  }
+
+ protected:
+  int overflow(int c) {
+    if (!drain(false))
+      return traits_type::eof();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  std::streamsize xsputn(const char *s, std::streamsize n) {
+    if (n > epptr() - pptr()) {
+      if (!drain(false))
+        return 0;
+      if (static_cast<size_t>(n) >= buffer.size())
+        return emit(s, n, false) ? n : 0;
+    }
+    std::memcpy(pptr(), s, n);
+    pbump(static_cast<int>(n));
+    return n;
+  }
+
+  int sync() {
+    return drain(true) ? 0 : -1;
+  }
+
+ public:
+  explicit Out_Buffer(int fd_ = 1, bool gz = false)
+    : fd(fd_), buffer(SIZE), failed(false), finished(false) {
+    setp(buffer.data(), buffer.data() + buffer.size());
+#ifdef GZIP_OUTPUT
+    gzip = gz;
+    if (gzip) {
+      std::memset(&z, 0, sizeof(z));
+      // 15 + 16: gzip header instead of the zlib one
+      if (deflateInit2(&z, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                       Z_DEFAULT_STRATEGY) != Z_OK)
+        throw std::runtime_error("cannot initialize gzip output");
+      zbuffer.resize(SIZE);
+    }
+#else
+    if (gz)
+      throw std::runtime_error("gzip output needs a program compiled with "
+                               "GZIP_OUTPUT");
+#endif
+  }
+
+  ~Out_Buffer() {
+    finish();
+#ifdef GZIP_OUTPUT
+    if (gzip)
+      deflateEnd(&z);
+#endif
+  }
+
+  Out_Buffer(const Out_Buffer&) = delete;
+  Out_Buffer &operator=(const Out_Buffer&) = delete;
+
+  // writes the buffer and ends the gzip stream; false on write errors
+  bool finish() {
+    if (finished)
+      return !failed;
+    bool r = drain(false);
+#ifdef GZIP_OUTPUT
+    if (gzip && !failed)
+      r = deflate_all(0, 0, Z_FINISH);
+#endif
+    finished = true;
+    failed = failed || !r;
+    return !failed;
+  }
+};
+
+/*
+   replaces the buffer of a stream, e.g. std::cout, by an Out_Buffer for
+   the lifetime of this object
+*/
+class Out_Redirect {
+ private:
+  std::ostream &o;
+  Out_Buffer buf;
+  std::streambuf *old;
+
+ public:
+  Out_Redirect(std::ostream &out, int fd, bool gzip)
+    : o(out), buf(fd, gzip), old(out.rdbuf(&buf)) {
+  }
+
+  ~Out_Redirect() {
+    o.flush();
+    buf.finish();
+    o.rdbuf(old);
+  }
+};
+
+}  // namespace gapc
+
+#endif  // RTLIB_OUT_BUFFER_HH_
@@ -25,12 +25,112 @@
 #ifndef RTLIB_OUTPUT_HH_
 #define RTLIB_OUTPUT_HH_
 
-#include <utility>
+#include <cstddef>
+#include <ios>
 #include <ostream>
+#include <type_traits>
+#include <utility>
+
+// std::to_chars for floating point needs C++17 and e.g. libstdc++ of
+// GCC 11
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
+
+template<typename L, typename R>
+inline std::ostream &operator<<(std::ostream &out, const std::pair<L, R> &p);
+
+namespace gapc {
+
+// numbers that std::ostream prints as numbers, i.e. not as characters
+template <typename T>
+struct chars_number
+  : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+                                 !std::is_same<T, bool>::value &&
+                                 !std::is_same<T, char>::value &&
+                                 !std::is_same<T, signed char>::value &&
+                                 !std::is_same<T, unsigned char>::value> {
+};
+
+#ifdef __cpp_lib_to_chars
+namespace output {
+
+// the end of the decimal digits of x in [b, e), or 0 for other bases
+template <typename T>
+inline char *to_chars(char *b, char *e, const T &x, const std::ostream &out,
+                      std::true_type) {
+  std::ios_base::fmtflags base = out.flags() & std::ios_base::basefield;
+  if (base == std::ios_base::hex || base == std::ios_base::oct)
+    return 0;
+  std::to_chars_result r = std::to_chars(b, e, x);
+  return r.ec == std::errc() ? r.ptr : 0;
+}
+
+// floating point x as the floatfield of out says, or 0 for hexfloat
+template <typename T>
+inline char *to_chars(char *b, char *e, const T &x, const std::ostream &out,
+                      std::false_type) {
+  std::ios_base::fmtflags fl = out.flags() & std::ios_base::floatfield;
+  int precision = static_cast<int>(out.precision());
+  std::chars_format f;
+  if (fl == std::ios_base::fixed)
+    f = std::chars_format::fixed;
+  else if (fl == std::ios_base::scientific)
+    f = std::chars_format::scientific;
+  else if (fl == std::ios_base::fmtflags(0))
+    f = std::chars_format::general;
+  else
+    return 0;
+  std::to_chars_result r = std::to_chars(b, e, x, f, precision);
+  return r.ec == std::errc() ? r.ptr : 0;
+}
+
+}  // namespace output
+#endif
+
+// out << x for all values that are not numbers
+template <typename T>
+inline typename std::enable_if<!chars_number<T>::value, std::ostream&>::type
+put(std::ostream &out, const T &x) {
+  return out << x;
+}
+
+/*
+   out << x, where numbers are formatted by std::to_chars into the
+   stream buffer, instead of by the locale dependent num_put facet; the
+   flags that to_chars doesn't support, and builds without
+   std::to_chars, fall back to the stream
+*/
+template <typename T>
+inline typename std::enable_if<chars_number<T>::value, std::ostream&>::type
+put(std::ostream &out, const T &x) {
+#ifdef __cpp_lib_to_chars
+  if (out.width() == 0 && out.good() &&
+      !(out.flags() & (std::ios_base::showpos | std::ios_base::showpoint |
+                       std::ios_base::showbase | std::ios_base::uppercase))) {
+    char buf[128];
+    char *e = output::to_chars(buf, buf + sizeof(buf), x, out,
+                               std::is_integral<T>());
+    if (e) {
+      std::streamsize n = e - buf;
+      if (out.rdbuf()->sputn(buf, n) != n)
+        out.setstate(std::ios_base::badbit);
+      return out;
+    }
+  }
+#endif
+  return out << x;
+}
+
+}  // namespace gapc
 
 template<typename L, typename R>
 inline std::ostream &operator<<(std::ostream &out, const std::pair<L, R> &p) {
-  out << "( " << p.first << " , " << p.second << " )";
+  out << "( ";
+  gapc::put(out, p.first) << " , ";
+  gapc::put(out, p.second) << " )";
   return out;
 }
 
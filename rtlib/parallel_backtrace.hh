@@ -0,0 +1,165 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+/*
+ * Parallel repeated backtracing (-r) after the forward computation. The
+ * repeats are split into contiguous chunks, which are backtraced by
+ * forked worker processes. The workers share the filled tables of the
+ * parent copy-on-write and keep private backtrace memo tables, memory
+ * pools and random number generators, since neither the rtlib memory
+ * pools nor the reference counts of the table values are thread safe.
+ * Each worker prints into its own buffer, which the parent copies to the
+ * output in worker order, i.e. the output only depends on the number of
+ * jobs and the random seed (GSL_RNG_SEED).
+ */
+
+#ifndef RTLIB_PARALLEL_BACKTRACE_HH_
+#define RTLIB_PARALLEL_BACKTRACE_HH_
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+}
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef USE_GSL
+#include "sample.hh"
+#endif
+
+namespace gapc {
+
+/*
+   worker w samples with the seed GSL_RNG_SEED + w, thus the first worker
+   draws the same samples as the serial backtrace
+*/
+inline void seed_backtrace_worker(unsigned w) {
+#ifdef USE_GSL
+  Singleton<scil::rng>::ref().seed(gsl_rng_default_seed + w);
+#endif
+}
+
+namespace parallel_bt {
+
+inline bool write_all(int fd, const std::string &s) {
+  const char *p = s.data();
+  size_t n = s.size();
+  while (n) {
+    ssize_t r = write(fd, p, n);
+    if (r < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    p += r;
+    n -= r;
+  }
+  return true;
+}
+
+inline void copy_all(int fd, std::ostream &out) {
+  char buf[1 << 16];
+  for (;;) {
+    ssize_t r = read(fd, buf, sizeof(buf));
+    if (r < 0 && errno == EINTR)
+      continue;
+    if (r <= 0)
+      break;
+    out.write(buf, r);
+  }
+}
+
+}  // namespace parallel_bt
+
+/*
+   calls print(out, n) for n backtraces; with jobs > 1 the repeats are
+   distributed over jobs forked workers
+*/
+template <typename F>
+void parallel_backtrace(std::ostream &out, unsigned repeats, unsigned jobs,
+                        F print) {
+  jobs = std::min(jobs, repeats);
+  if (jobs <= 1) {
+    print(out, repeats);
+    return;
+  }
+  out.flush();
+  std::cout.flush();
+  std::cerr.flush();
+  std::vector<std::pair<pid_t, int> > workers;
+  for (unsigned w = 0; w < jobs; ++w) {
+    int fd[2];
+    if (pipe(fd) != 0)
+      throw std::runtime_error("cannot create backtrace worker pipe");
+    pid_t pid = fork();
+    if (pid < 0)
+      throw std::runtime_error("cannot fork backtrace worker");
+    if (pid == 0) {
+      close(fd[0]);
+      for (size_t i = 0; i < workers.size(); ++i)
+        close(workers[i].second);
+      int ret = 0;
+      try {
+        seed_backtrace_worker(w);
+        unsigned first = static_cast<uint64_t>(repeats) * w / jobs;
+        unsigned last = static_cast<uint64_t>(repeats) * (w + 1) / jobs;
+        std::ostringstream o;
+        print(o, last - first);
+        if (!parallel_bt::write_all(fd[1], o.str()))
+          ret = 1;
+      } catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << '\n';
+        ret = 1;
+      }
+      std::cerr.flush();
+      // no exit handlers and destructors of the parent's state
+      _exit(ret);
+    }
+    close(fd[1]);
+    workers.push_back(std::make_pair(pid, fd[0]));
+  }
+  bool ok = true;
+  for (size_t i = 0; i < workers.size(); ++i) {
+    parallel_bt::copy_all(workers[i].second, out);
+    close(workers[i].second);
+    int status = 0;
+    while (waitpid(workers[i].first, &status, 0) < 0 && errno == EINTR) {
+    }
+    ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  }
+  if (!ok)
+    throw std::runtime_error("backtrace worker failed");
+}
+
+}  // namespace gapc
+
+#endif  // RTLIB_PARALLEL_BACKTRACE_HH_
@@ -451,15 +451,13 @@ class Ref {
             z = i->size();
             assert(z == Block<Refcount>::block_size);
           }
-          for (unsigned char j = 0; j < z; ++j)
-            o << i->array[j];
+          o.write(reinterpret_cast<const char*>(i->array), z);
           i = i->next;
         }
       } else {
         Block<Refcount>* i = first;
         while (i) {
-          for (unsigned char j = 0; j < i->size(); ++j)
-            o << i->array[j];
+          o.write(reinterpret_cast<const char*>(i->array), i->size());
           i = i->next;
         }
       }
@@ -476,15 +474,13 @@ class Ref {
             z = i->size();
             assert(z == Block<Refcount>::block_size);
           }
-          for (unsigned char j = 0; j < z; ++j)
-            o << i->array[j];
+          o.write(reinterpret_cast<const char*>(i->array), z);
           i = i->next;
         }
       } else {
         Block<Refcount>* i = first;
         while (i) {
-          for (unsigned char j = 0; j < i->size(); ++j)
-            o << i->array[j];
+          o.write(reinterpret_cast<const char*>(i->array), i->size());
           i = i->next;
         }
       }
@@ -501,15 +497,13 @@ class Ref {
             z = i->size();
             assert(z == Block<Refcount>::block_size);
           }
-          for (unsigned char j = 0; j < z; ++j)
-            o << i->array[j];
+          o.write(reinterpret_cast<const char*>(i->array), z);
           i = i->next;
         }
       } else {
         Block<Refcount>* i = first;
         while (i) {
-          for (unsigned char j = 0; j < i->size(); ++j)
-            o << i->array[j];
+          o.write(reinterpret_cast<const char*>(i->array), i->size());
           i = i->next;
         }
       }
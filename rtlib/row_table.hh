@@ -0,0 +1,250 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+/*
+ * Storage for the tables of programs compiled with gapc --linear-space.
+ * Their cyk loops compute the rows of the tables, i.e. the cells of one
+ * left index of track 0, from the last row to the first one, and a row
+ * only depends on the next depth rows. Thus of the rows, which are
+ * grouped into blocks of K rows, only two blocks plus the first depth
+ * rows of each block are kept, i.e. O(sqrt(n depth)) rows for the
+ * default K = sqrt(n depth) instead of n. A backtrace, which reads a row
+ * of an evicted block, recomputes this block of all tables from the
+ * checkpointed first rows of the block below it, i.e. most of the rows
+ * are computed twice.
+ */
+
+#ifndef RTLIB_ROW_TABLE_HH_
+#define RTLIB_ROW_TABLE_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace Table {
+
+/*
+   the blocks of rows of all tables of a program; the generated
+   cyk_rows(hi, lo) recomputes the rows hi down to lo of all tables
+*/
+class Row_Blocks {
+ public:
+  class Client {
+   public:
+    virtual ~Client() {}
+    // block b is recomputed, its cells are reset
+    virtual void load(size_t b) = 0;
+  };
+
+ private:
+  size_t rows_;
+  size_t depth_;
+  size_t block_rows_;
+  std::vector<Client*> clients;
+  std::function<void(size_t, size_t)> fill;
+  bool filling;
+
+ public:
+  Row_Blocks() : rows_(1), depth_(1), block_rows_(1), filling(false) {
+  }
+
+  // block_rows: rows per block, 0: the square root of rows * depth
+  void init(size_t rows, size_t depth,
+            const std::function<void(size_t, size_t)> &f,
+            size_t block_rows = 0) {
+    rows_ = std::max<size_t>(rows, 1);
+    depth_ = std::max<size_t>(depth, 1);
+    if (!block_rows) {
+      block_rows = static_cast<size_t>(
+        std::ceil(std::sqrt(static_cast<double>(rows_) * depth_)));
+    }
+    block_rows_ = std::max(block_rows, depth_);
+    clients.clear();
+    fill = f;
+    filling = false;
+  }
+
+  size_t rows() const {
+    return rows_;
+  }
+
+  size_t depth() const {
+    return depth_;
+  }
+
+  size_t block_rows() const {
+    return block_rows_;
+  }
+
+  size_t blocks() const {
+    return (rows_ + block_rows_ - 1) / block_rows_;
+  }
+
+  void attach(Client *c) {
+    clients.push_back(c);
+  }
+
+  void recompute(size_t b) {
+    if (filling) {
+      // the checkpointed rows don't cover the dependencies of a row
+      throw std::logic_error("row depth of the tables exceeded");
+    }
+    for (std::vector<Client*>::iterator i = clients.begin();
+         i != clients.end(); ++i) {
+      (*i)->load(b);
+    }
+    size_t lo = b * block_rows_;
+    size_t hi = std::min(rows_, lo + block_rows_) - 1;
+    filling = true;
+    try {
+      fill(hi, lo);
+    } catch (...) {
+      filling = false;
+      throw;
+    }
+    filling = false;
+  }
+};
+
+template <typename T>
+class Rows : public Row_Blocks::Client {
+ private:
+  static const size_t NONE = ~size_t(0);
+
+  Row_Blocks *blocks;
+  size_t n;
+  size_t block_len;
+  size_t checkpoint_len;
+  // the two resident blocks
+  std::unique_ptr<T[]> slot[2];
+  size_t slot_block[2];
+  // the first depth rows of the blocks below the lowest one
+  std::vector<std::unique_ptr<T[]> > checkpoints;
+  // the lowest block (i.e. of the lowest rows) the cyk loops entered
+  size_t lowest;
+
+  static size_t distance(size_t a, size_t b) {
+    if (a == NONE) {
+      return NONE;
+    }
+    return a < b ? b - a : a - b;
+  }
+
+  // the slot of the resident block farther away from block b
+  size_t victim(size_t b) const {
+    return distance(slot_block[0], b) >= distance(slot_block[1], b) ? 0 : 1;
+  }
+
+  void reset(size_t s, size_t b) {
+    std::fill(slot[s].get(), slot[s].get() + block_len, T());
+    slot_block[s] = b;
+  }
+
+  // the cyk loops enter block b, all rows of block lowest are computed
+  void advance(size_t b) {
+    for (size_t s = 0; s < 2; ++s) {
+      if (slot_block[s] == lowest) {
+        size_t k = std::min(checkpoint_len, n - lowest * block_len);
+        checkpoints[lowest].reset(new T[checkpoint_len]());
+        std::copy(slot[s].get(), slot[s].get() + k,
+                  checkpoints[lowest].get());
+      }
+    }
+    reset(victim(b), b);
+    lowest = b;
+  }
+
+ public:
+  typedef T value_type;
+
+  Rows() : blocks(0), n(0), block_len(0), checkpoint_len(0), lowest(0) {
+    slot_block[0] = slot_block[1] = NONE;
+  }
+
+  // cells: the size of the table, a multiple of the number of rows
+  void init(Row_Blocks &b, size_t cells) {
+    blocks = &b;
+    n = cells;
+    size_t row_len = cells / b.rows();
+    assert(row_len * b.rows() == cells);
+    block_len = row_len * b.block_rows();
+    checkpoint_len = row_len * b.depth();
+    for (size_t s = 0; s < 2; ++s) {
+      slot[s].reset(new T[block_len]());
+      slot_block[s] = NONE;
+    }
+    checkpoints.clear();
+    checkpoints.resize(b.blocks());
+    lowest = b.blocks();
+    b.attach(this);
+  }
+
+  size_t size() const {
+    return n;
+  }
+
+  void load(size_t b) {
+    reset(victim(b), b);
+  }
+
+  // the number of cells that are kept
+  size_t resident() const {
+    size_t r = 2 * block_len;
+    for (size_t i = 0; i < checkpoints.size(); ++i) {
+      if (checkpoints[i]) {
+        r += checkpoint_len;
+      }
+    }
+    return r;
+  }
+
+  T &operator[](size_t off) {
+    assert(off < n);
+    size_t b = off / block_len;
+    size_t x = off - b * block_len;
+    for (;;) {
+      for (size_t s = 0; s < 2; ++s) {
+        if (slot_block[s] == b) {
+          return slot[s][x];
+        }
+      }
+      if (x < checkpoint_len && checkpoints[b]) {
+        return checkpoints[b][x];
+      }
+      if (b < lowest) {
+        advance(b);
+      } else {
+        blocks->recompute(b);
+      }
+    }
+  }
+};
+
+}  // namespace Table
+
+#endif  // RTLIB_ROW_TABLE_HH_
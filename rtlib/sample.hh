@@ -65,6 +65,10 @@ class rng {
     const gsl_rng *operator*() const {
       return t;
     }
+
+    void seed(unsigned long s) {  // NOLINT [runtime/int]
+      gsl_rng_set(t, s);
+    }
 };
 
 class ran_discrete {
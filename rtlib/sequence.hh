@@ -36,9 +36,21 @@
 #include <sstream>
 #include <vector>
 #include <cstdlib>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>  // NOLINT [build/c++11]
 
 #include <stdexcept>
 
+// std::from_chars for double needs C++17 and e.g. libstdc++ of GCC 11
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
+
 template<typename alphabet = char>
 struct Copier {
   std::pair<alphabet*, size_t> copy(const char *x, size_t l) const {
@@ -46,92 +58,180 @@ struct Copier {
     std::memcpy(r, x, l);
     return std::make_pair(r, l);
   }
+  // characters are bytes anyway
+  std::pair<alphabet*, size_t> copy_binary(const char *x, size_t l) const {
+    return copy(x, l);
+  }
   unsigned rows() const { return 1; }
   char *row(char *seq, unsigned x) { return seq; }
   const char *row(char *seq, unsigned x) const { return seq; }
 };
 
+/*
+   Parsing of whitespace separated numbers in a single pass over the
+   text: the tokens are counted first and then converted directly into
+   the final array. Tokens that std::from_chars doesn't take completely
+   (e.g. hex numbers, a leading '+', garbage or out of range values) are
+   handed to strtod/strtol, thus the values and the error handling are
+   the same as with parsing via a std::stringstream. Without
+   std::from_chars (__cpp_lib_to_chars), all tokens take the strtod/strtol
+   path.
+*/
+namespace numeric_input {
+
+inline bool is_space(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// the text ends at l or at the first 0 byte; sets l to the end
+inline size_t count_tokens(const char *x, size_t &l) {
+  size_t n = 0;
+  bool in_token = false;
+  size_t i = 0;
+  for (; i < l && x[i]; ++i) {
+    bool space = is_space(x[i]);
+    if (!space && !in_token)
+      ++n;
+    in_token = !space;
+  }
+  l = i;
+  return n;
+}
+
+// calls f(begin, end) for each token, until it returns false
+template <typename F>
+inline void for_each_token(const char *x, size_t l, F f) {
+  const char *end = x + l;
+  for (const char *i = x; ; ) {
+    while (i != end && is_space(*i))
+      ++i;
+    if (i == end)
+      return;
+    const char *b = i;
+    while (i != end && !is_space(*i))
+      ++i;
+    if (!f(b, i))
+      return;
+  }
+}
+
+// returns false on range errors
+inline bool parse_double(const char *b, const char *e, double &d) {
+#ifdef __cpp_lib_to_chars
+  std::from_chars_result r = std::from_chars(b, e, d);
+  // strtod reports subnormal results as range errors
+  if (r.ec == std::errc() && r.ptr == e &&
+      !(d != 0 && std::fabs(d) < std::numeric_limits<double>::min()))
+    return true;
+#endif
+  std::string t(b, e);
+  errno = 0;
+  d = std::strtod(t.c_str(), 0);
+  return !errno;
+}
+
+// base as with strtol(.., 0), i.e. hex and octal numbers are accepted
+inline bool parse_int(const char *b, const char *e, int &v) {
+#ifdef __cpp_lib_to_chars
+  const char *d = b + (*b == '-');
+  if (d != e && (*d != '0' || d + 1 == e)) {
+    long x;
+    std::from_chars_result r = std::from_chars(b, e, x);
+    if (r.ec == std::errc() && r.ptr == e) {
+      v = static_cast<int>(x);
+      return true;
+    }
+  }
+#endif
+  std::string t(b, e);
+  errno = 0;
+  v = static_cast<int>(std::strtol(t.c_str(), 0, 0));
+  return !errno;
+}
+
+template <typename T, typename F>
+inline std::pair<T*, size_t> parse(const char *x, size_t l, F convert) {
+  size_t n = count_tokens(x, l);
+  std::unique_ptr<T[]> arr(new T[n]);
+  size_t k = 0;
+  for_each_token(x, l, [&arr, &k, &convert](const char *b, const char *e) {
+    if (!convert(b, e, arr[k]))
+      return false;
+    ++k;
+    return true;
+  });
+  return std::make_pair(arr.release(), k);
+}
+
+/*
+   raw binary input, i.e. an array of little endian values, e.g. a
+   memory mapped file of float32, float64 or int32 values
+*/
+template <typename T>
+inline std::pair<T*, size_t> copy_binary(const char *x, size_t l) {
+  if (l % sizeof(T))
+    throw std::length_error(
+      "Binary input size is not a multiple of the value size.");
+  size_t n = l / sizeof(T);
+  T *arr = new T[n];
+  std::memcpy(arr, x, l);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  char *c = reinterpret_cast<char*>(arr);
+  for (size_t i = 0; i < l; i += sizeof(T))
+    std::reverse(c + i, c + i + sizeof(T));
+#endif
+  return std::make_pair(arr, n);
+}
+
+}  // namespace numeric_input
+
 template<>
 struct Copier<double> {
   std::pair<double*, size_t> copy(const char *x, size_t l) const {
-    std::stringstream s;
-    s << x;
-    std::vector<double> v;
-    for (;;) {
-      // to parse reliable NaNs etc.
-      std::string str;
-      s >> str;
-      errno = 0;
-      double d = std::strtod(str.c_str(), 0);
-      if (errno)
-        break;
-      if (s.bad() || s.fail())
-        break;
-      v.push_back(d);
-      if (s.eof())
-        break;
-    }
-    double *arr = new double[v.size()];
-    double *t = arr;
-    for (std::vector<double>::iterator i = v.begin(); i != v.end(); ++i, ++t)
-      *t = *i;
-    return std::make_pair(arr, v.size());
+    // stops at the first out of range value
+    return numeric_input::parse<double>(x, l, numeric_input::parse_double);
+  }
+  std::pair<double*, size_t> copy_binary(const char *x, size_t l) const {
+    return numeric_input::copy_binary<double>(x, l);
   }
 };
 
 template<>
 struct Copier<float> {
   std::pair<float*, size_t> copy(const char *x, size_t l) const {
-    std::stringstream s;
-    s << x;
-    std::vector<float> v;
-    for (;;) {
-      // to parse reliable NaNs etc.
-      std::string str;
-      s >> str;
-      errno = 0;
-      float d = std::strtod(str.c_str(), 0);
-      if (errno)
-        break;
-      if (s.bad() || s.fail())
-        break;
-      v.push_back(d);
-      if (s.eof())
-        break;
-    }
-    float *arr = new float[v.size()];
-    float *t = arr;
-    for (std::vector<float>::iterator i = v.begin(); i != v.end(); ++i, ++t)
-      *t = *i;
-    return std::make_pair(arr, v.size());
+    return numeric_input::parse<float>(x, l,
+      [](const char *b, const char *e, float &f) {
+        double d;
+        if (!numeric_input::parse_double(b, e, d))
+          return false;
+        f = d;
+        return true;
+      });
+  }
+  std::pair<float*, size_t> copy_binary(const char *x, size_t l) const {
+    static_assert(sizeof(float) == 4, "binary input expects float32");
+    return numeric_input::copy_binary<float>(x, l);
   }
 };
 
 template<>
 struct Copier<int> {
   std::pair<int*, size_t> copy(const char *x, size_t l) const {
-    std::stringstream s;
-    s << x;
-    std::vector<int> v;
-    for (;;) {
-      // to parse reliable NaNs etc.
-      std::string str;
-      s >> str;
-      errno = 0;
-      int d = std::strtol(str.c_str(), 0, 0);
-      if (errno)
-        throw std::runtime_error("Int convert error.");
-      if (s.bad() || s.fail())
-        throw std::runtime_error("Int input error.");
-      v.push_back(d);
-      if (s.eof())
-        break;
+    std::pair<int*, size_t> r = numeric_input::parse<int>(x, l,
+      [](const char *b, const char *e, int &v) {
+        if (!numeric_input::parse_int(b, e, v))
+          throw std::runtime_error("Int convert error.");
+        return true;
+      });
+    if (!r.second) {
+      delete[] r.first;
+      throw std::runtime_error("Int input error.");
     }
-    int *arr = new int[v.size()];
-    int *t = arr;
-    for (std::vector<int>::iterator i = v.begin(); i != v.end(); ++i, ++t)
-      *t = *i;
-    return std::make_pair(arr, v.size());
+    return r;
+  }
+  std::pair<int*, size_t> copy_binary(const char *x, size_t l) const {
+    static_assert(sizeof(int) == 4, "binary input expects int32");
+    return numeric_input::copy_binary<int>(x, l);
   }
 };
 
@@ -219,6 +319,9 @@ struct Copier<M_Char> {
     }
     return std::make_pair(r, row_size_);
   }
+  std::pair<alphabet*, size_t> copy_binary(const char *x, size_t l) {
+    return copy(x, l);
+  }
   pos_type rows() const {
     return rows_;
   }
@@ -236,21 +339,121 @@ struct Copier<M_Char> {
   }
 };
 
+/*
+   Per position lexing tables of a character sequence for the INT and
+   FLOAT terminal parsers (see terminal.hh), such that these check and
+   evaluate a span in O(1) instead of re-scanning it for each of the
+   O(n^2) spans a tokenizing grammar asks for.
+*/
+class Numeric_Lex {
+ private:
+    // number of consecutive digits / digits or '.' starting at a position
+    std::vector<uint32_t> digit_run, number_run;
+    // number of '.' before a position
+    std::vector<uint32_t> dot_count;
+    // position of the next '.' at or right of a position
+    std::vector<uint32_t> next_dot_;
+    // digit values of the prefixes modulo 2^64, restarting after each
+    // non-digit; for digits_value the '.' are skipped
+    std::vector<uint64_t> int_prefix, digits_prefix;
+
+    static uint64_t pow10(size_t k) {
+      // 10^k mod 2^64 is 0 for k >= 64
+      uint64_t r = 1;
+      for (; k && r; --k)
+        r *= 10;
+      return r;
+    }
+
+ public:
+    template<typename alphabet>
+    void init(const alphabet *seq, size_t n) {
+      digit_run.assign(n + 1, 0);
+      number_run.assign(n + 1, 0);
+      dot_count.assign(n + 1, 0);
+      next_dot_.assign(n + 1, n);
+      int_prefix.assign(n + 1, 0);
+      digits_prefix.assign(n + 1, 0);
+      for (size_t a = n; a > 0; --a) {
+        char c = seq[a - 1];
+        bool digit = c >= '0' && c <= '9';
+        digit_run[a - 1] = digit ? digit_run[a] + 1 : 0;
+        number_run[a - 1] = digit || c == '.' ? number_run[a] + 1 : 0;
+        next_dot_[a - 1] = c == '.' ? a - 1 : next_dot_[a];
+      }
+      for (size_t a = 0; a < n; ++a) {
+        char c = seq[a];
+        bool digit = c >= '0' && c <= '9';
+        dot_count[a + 1] = dot_count[a] + (c == '.');
+        int_prefix[a + 1] = digit ? int_prefix[a] * 10 + (c - '0') : 0;
+        if (digit)
+          digits_prefix[a + 1] = digits_prefix[a] * 10 + (c - '0');
+        else
+          digits_prefix[a + 1] = c == '.' ? digits_prefix[a] : 0;
+      }
+    }
+
+    size_t digits(size_t i) const { return digit_run[i]; }
+    size_t number_chars(size_t i) const { return number_run[i]; }
+    size_t dots(size_t i, size_t j) const {
+      return dot_count[j] - dot_count[i];
+    }
+    size_t next_dot(size_t i) const { return next_dot_[i]; }
+
+    // value of the digits of [i, j) modulo 2^64, if all are digits
+    uint64_t int_value(size_t i, size_t j) const {
+      return int_prefix[j] - int_prefix[i] * pow10(j - i);
+    }
+    // value of the digits of [i, j) modulo 2^64, ignoring '.', if all
+    // are digits or '.'
+    uint64_t digits_value(size_t i, size_t j) const {
+      return digits_prefix[j] - digits_prefix[i] * pow10(j - i - dots(i, j));
+    }
+};
+
 template<typename alphabet = char, typename pos_type = unsigned int>
 class Basic_Sequence {
  private:
     Copier<alphabet> copier;  // to let Copier cleanup shared storage
 
+    struct Lex_Cache {
+      std::once_flag once;
+      Numeric_Lex lex;
+    };
+    // built on first use, since most programs don't parse numbers
+    std::unique_ptr<Lex_Cache> lex_cache;
+
  public:
     alphabet *seq;
     pos_type n;
 
     void copy(const char *s, pos_type l) {
+      std::pair<alphabet*, size_t> p = copier.copy(s, l);
       delete[] seq;
+      seq = p.first;
+      n = p.second;
+      lex_cache.reset(new Lex_Cache());
+    }
 
-      std::pair<alphabet*, size_t> p = copier.copy(s, l);
+    // for raw binary input of numbers, see numeric_input::copy_binary
+    void copy_binary(const char *s, pos_type l) {
+      std::pair<alphabet*, size_t> p = copier.copy_binary(s, l);
+      delete[] seq;
       seq = p.first;
       n = p.second;
+      lex_cache.reset(new Lex_Cache());
+    }
+
+    /*
+       the sequence must not be modified after the first call, the
+       tables are built thread safe, e.g. for the OpenMP cyk loops
+    */
+    const Numeric_Lex &numeric_lex() {
+      if (!lex_cache)
+        lex_cache.reset(new Lex_Cache());
+      Lex_Cache &c = *lex_cache;
+      std::call_once(c.once, [this, &c] { c.lex.init(seq, n); });
+      return c.lex;
     }
 
  public:
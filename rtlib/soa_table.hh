@@ -0,0 +1,117 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+/*
+ * Structure of arrays storage for the cells of generated tables of
+ * pair typed answers, e.g. of lexicographic products like mfe * pf.
+ * The components are stored in two parallel arrays, such that a loop
+ * which only compares the first component (the score) only pulls those
+ * into the cache. Cells are read by value, i.e. the generated get()
+ * functions of these tables return an std::pair instead of a reference
+ * into the table; code that only uses .first of the returned pair
+ * doesn't load the second component after inlining.
+ * Bool components are kept as unsigned char, since the bit packed
+ * std::vector<bool> would let the OpenMP cyk threads, which write
+ * neighbouring cells, race on the same word.
+ */
+
+#ifndef RTLIB_SOA_TABLE_HH_
+#define RTLIB_SOA_TABLE_HH_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Table {
+
+template <typename T>
+class SoA;
+
+// element type of the array of one component
+template <typename T>
+struct SoA_Component {
+  typedef T type;
+};
+
+template <>
+struct SoA_Component<bool> {
+  typedef unsigned char type;
+};
+
+template <typename A, typename B>
+class SoA<std::pair<A, B> > {
+ private:
+  std::vector<typename SoA_Component<A>::type> first;
+  std::vector<typename SoA_Component<B>::type> second;
+
+ public:
+  typedef std::pair<A, B> value_type;
+
+  // a cell, as returned by operator[] for reading and writing
+  class Ref {
+   private:
+    SoA &t;
+    size_t k;
+
+   public:
+    Ref(SoA &t, size_t k) : t(t), k(k) {
+    }
+
+    operator value_type() const {
+      return value_type(static_cast<A>(t.first[k]),
+                        static_cast<B>(t.second[k]));
+    }
+
+    Ref &operator=(const value_type &x) {
+      t.first[k] = x.first;
+      t.second[k] = x.second;
+      return *this;
+    }
+  };
+
+  void resize(size_t n) {
+    first.resize(n);
+    second.resize(n);
+  }
+
+  void clear() {
+    first.clear();
+    second.clear();
+  }
+
+  size_t size() const {
+    return first.size();
+  }
+
+  Ref operator[](size_t k) {
+    return Ref(*this, k);
+  }
+
+  value_type operator[](size_t k) const {
+    return value_type(static_cast<A>(first[k]), static_cast<B>(second[k]));
+  }
+};
+
+}  // namespace Table
+
+#endif  // RTLIB_SOA_TABLE_HH_
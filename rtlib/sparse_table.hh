@@ -0,0 +1,155 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+/*
+ * Storage for the cells of generated tables, of which only a small
+ * fraction is ever computed, e.g. quadratic tables of non-terminals with a
+ * constant maximal yield size or with heavy filters. Cells are addressed
+ * by the same linear offset as the dense std::vector storage, which is
+ * hashed into an open addressing index with linear probing. The values
+ * themselves are appended to a deque, such that references returned by
+ * the generated get() functions stay valid while the index grows.
+ * Not thread safe, thus gapc uses it only in top-down mode.
+ */
+
+#ifndef RTLIB_SPARSE_TABLE_HH_
+#define RTLIB_SPARSE_TABLE_HH_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Table {
+
+template <typename T>
+class Sparse {
+ private:
+  struct Slot {
+    size_t key;
+    size_t value;
+  };
+
+  static const size_t EMPTY = ~size_t(0);
+
+  // power of 2
+  std::vector<Slot> index;
+  std::deque<T> values;
+  size_t n;
+
+  size_t mask() const {
+    return index.size() - 1;
+  }
+
+  static size_t hash(size_t key) {
+    // fibonacci hashing, spreads the consecutive offsets of a row
+    uint64_t h = static_cast<uint64_t>(key) * 0x9e3779b97f4a7c15ULL;
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
+
+  void grow() {
+    std::vector<Slot> old;
+    old.swap(index);
+    Slot e = { EMPTY, 0 };
+    index.resize(old.empty() ? 64 : 2 * old.size(), e);
+    for (typename std::vector<Slot>::iterator i = old.begin();
+         i != old.end(); ++i) {
+      if (i->key == EMPTY) {
+        continue;
+      }
+      size_t k = hash(i->key) & mask();
+      while (index[k].key != EMPTY) {
+        k = (k + 1) & mask();
+      }
+      index[k] = *i;
+    }
+  }
+
+ public:
+  Sparse() : n(0) {
+  }
+
+  // number of addressable cells, like std::vector::resize() of the
+  // dense storage, but does not allocate them
+  void resize(size_t size) {
+    clear();
+    n = size;
+  }
+
+  void clear() {
+    index.clear();
+    values.clear();
+  }
+
+  size_t size() const {
+    return n;
+  }
+
+  // number of stored cells
+  size_t count() const {
+    return values.size();
+  }
+
+  bool contains(size_t key) const {
+    if (index.empty()) {
+      return false;
+    }
+    for (size_t k = hash(key) & mask(); ; k = (k + 1) & mask()) {
+      if (index[k].key == key) {
+        return true;
+      }
+      if (index[k].key == EMPTY) {
+        return false;
+      }
+    }
+  }
+
+  // inserts a default constructed cell on first access
+  T &operator[](size_t key) {
+    assert(key < n);
+    // max load factor of 1/2
+    if (2 * (values.size() + 1) > index.size()) {
+      grow();
+    }
+    size_t k = hash(key) & mask();
+    for (; index[k].key != EMPTY; k = (k + 1) & mask()) {
+      if (index[k].key == key) {
+        return values[index[k].value];
+      }
+    }
+    index[k].key = key;
+    index[k].value = values.size();
+    values.push_back(T());
+    return values.back();
+  }
+
+  // allocated bytes, without memory owned by the values themselves
+  size_t bytes() const {
+    return index.capacity() * sizeof(Slot) + values.size() * sizeof(T);
+  }
+};
+
+}  // namespace Table
+
+#endif  // RTLIB_SPARSE_TABLE_HH_
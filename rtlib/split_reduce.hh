@@ -0,0 +1,218 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+/*
+ * Fused reductions over the split points k of a recurrence like
+ *
+ *   min_k T(i, k) + U(k, j)
+ *
+ * with a scalar min or max choice function, e.g. split(start, bp) of
+ * Nussinov with split(l, r) = l + r. a[k] is T(i, k), i.e. a row of a
+ * table, which is contiguous in the transposed copy of the table, and b[k]
+ * is U(k, j), i.e. a column, which is contiguous in the table itself, see
+ * Alt::Simple::init_split_reduce() in src/alt.cc. The result is empty, if
+ * for no k in [k, end) both a[k] and b[k] are non-empty.
+ *
+ * Empty cells are masked out instead of checked in branches. For int and
+ * float, 4 split points are reduced at once with SSE2 (part of every
+ * x86-64 CPU); the other types and the remaining split points use the
+ * same masking in scalar code.
+ */
+
+#ifndef RTLIB_SPLIT_REDUCE_HH_
+#define RTLIB_SPLIT_REDUCE_HH_
+
+#include <cstddef>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "empty.hh"
+
+namespace gapc {
+namespace split {
+
+// the neutral element of max, which no candidate undercuts
+template<typename T>
+inline T lowest() {
+  return std::numeric_limits<T>::has_infinity ?
+    -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+}
+
+}  // namespace split
+}  // namespace gapc
+
+template<typename T>
+inline T split_min_plus(const T *a, const T *b, size_t k, size_t end) {
+  T e;
+  empty(e);
+  T r = e;
+  for (; k < end; ++k) {
+    T x = a[k];
+    T y = b[k];
+    bool mask = isEmpty(x) | isEmpty(y);
+    // no arithmetic on the empty value, which would overflow for int
+    T v = (mask ? T(0) : x) + (mask ? T(0) : y);
+    v = mask ? e : v;
+    r = v < r ? v : r;
+  }
+  return r;
+}
+
+template<typename T>
+inline T split_max_plus(const T *a, const T *b, size_t k, size_t end) {
+  const T lowest = gapc::split::lowest<T>();
+  T r = lowest;
+  bool found = false;
+  for (; k < end; ++k) {
+    T x = a[k];
+    T y = b[k];
+    bool mask = isEmpty(x) | isEmpty(y);
+    T v = (mask ? T(0) : x) + (mask ? T(0) : y);
+    v = mask ? lowest : v;
+    r = r < v ? v : r;
+    found |= !mask;
+  }
+  if (!found) {
+    empty(r);
+  }
+  return r;
+}
+
+#if defined(__SSE2__)
+
+namespace gapc {
+namespace split {
+
+// m ? a : b
+inline __m128i select(__m128i m, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+}
+
+inline __m128 select(__m128 m, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+}
+
+}  // namespace split
+}  // namespace gapc
+
+inline int split_min_plus(const int *a, const int *b, size_t k, size_t end) {
+  const __m128i e = _mm_set1_epi32(std::numeric_limits<int>::max());
+  __m128i r = e;
+  for (; k + 4 <= end; k += 4) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + k));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + k));
+    __m128i m = _mm_or_si128(_mm_cmpeq_epi32(x, e), _mm_cmpeq_epi32(y, e));
+    // the sum of masked lanes wraps around, it is replaced by empty
+    __m128i v = gapc::split::select(m, e, _mm_add_epi32(x, y));
+    r = gapc::split::select(_mm_cmplt_epi32(v, r), v, r);
+  }
+  int l[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(l), r);
+  int s = split_min_plus<int>(a, b, k, end);
+  for (unsigned i = 0; i < 4; ++i) {
+    s = l[i] < s ? l[i] : s;
+  }
+  return s;
+}
+
+inline int split_max_plus(const int *a, const int *b, size_t k, size_t end) {
+  const __m128i e = _mm_set1_epi32(std::numeric_limits<int>::max());
+  const __m128i lowest = _mm_set1_epi32(gapc::split::lowest<int>());
+  __m128i r = lowest;
+  __m128i found = _mm_setzero_si128();
+  for (; k + 4 <= end; k += 4) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + k));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + k));
+    __m128i m = _mm_or_si128(_mm_cmpeq_epi32(x, e), _mm_cmpeq_epi32(y, e));
+    __m128i v = gapc::split::select(m, lowest, _mm_add_epi32(x, y));
+    r = gapc::split::select(_mm_cmpgt_epi32(v, r), v, r);
+    found = _mm_or_si128(found, _mm_andnot_si128(m, _mm_set1_epi32(-1)));
+  }
+  int s = split_max_plus<int>(a, b, k, end);
+  if (_mm_movemask_epi8(found)) {
+    int l[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(l), r);
+    if (isEmpty(s)) {
+      s = l[0];
+    }
+    for (unsigned i = 0; i < 4; ++i) {
+      s = s < l[i] ? l[i] : s;
+    }
+  }
+  return s;
+}
+
+inline float split_min_plus(const float *a, const float *b, size_t k,
+                            size_t end) {
+  const __m128 e = _mm_set1_ps(std::numeric_limits<float>::infinity());
+  __m128 r = e;
+  for (; k + 4 <= end; k += 4) {
+    __m128 x = _mm_loadu_ps(a + k);
+    __m128 y = _mm_loadu_ps(b + k);
+    __m128 m = _mm_or_ps(_mm_cmpeq_ps(x, e), _mm_cmpeq_ps(y, e));
+    __m128 v = gapc::split::select(m, e, _mm_add_ps(x, y));
+    r = _mm_min_ps(v, r);
+  }
+  float l[4];
+  _mm_storeu_ps(l, r);
+  float s = split_min_plus<float>(a, b, k, end);
+  for (unsigned i = 0; i < 4; ++i) {
+    s = l[i] < s ? l[i] : s;
+  }
+  return s;
+}
+
+inline float split_max_plus(const float *a, const float *b, size_t k,
+                            size_t end) {
+  const __m128 e = _mm_set1_ps(std::numeric_limits<float>::infinity());
+  const __m128 lowest = _mm_set1_ps(gapc::split::lowest<float>());
+  __m128 r = lowest;
+  __m128 found = _mm_setzero_ps();
+  for (; k + 4 <= end; k += 4) {
+    __m128 x = _mm_loadu_ps(a + k);
+    __m128 y = _mm_loadu_ps(b + k);
+    __m128 m = _mm_or_ps(_mm_cmpeq_ps(x, e), _mm_cmpeq_ps(y, e));
+    __m128 v = gapc::split::select(m, lowest, _mm_add_ps(x, y));
+    r = _mm_max_ps(v, r);
+    found = _mm_or_ps(found, _mm_andnot_ps(m, _mm_cmpeq_ps(e, e)));
+  }
+  float s = split_max_plus<float>(a, b, k, end);
+  if (_mm_movemask_ps(found)) {
+    float l[4];
+    _mm_storeu_ps(l, r);
+    if (isEmpty(s)) {
+      s = l[0];
+    }
+    for (unsigned i = 0; i < 4; ++i) {
+      s = s < l[i] ? l[i] : s;
+    }
+  }
+  return s;
+}
+
+#endif
+
+#endif  // RTLIB_SPLIT_REDUCE_HH_
@@ -52,10 +52,14 @@ void String::Block::put(std::ostream &s) const {
         b->put(s);
         break;
       case SEQ :
-        ++i;
-        for (; array[i] != SEQ_END; ++i)
-          s << (static_cast<char>(array[i]));
-        ++i;
+        {
+          ++i;
+          unsigned char e = i;
+          while (array[e] != SEQ_END)
+            ++e;
+          s.write(reinterpret_cast<const char*>(array + i), e - i);
+          i = e + 1;
+        }
         break;
       case REP :
         ++i;
@@ -65,7 +69,7 @@ void String::Block::put(std::ostream &s) const {
         ( (unsigned char*) &a)[2] = array[i+3];
         ( (unsigned char*) &a)[3] = array[i+4];
         for (uint32_t b = 0; b < a; b++)
-          s << static_cast<char>(array[i]);
+          s.put(static_cast<char>(array[i]));
         i++;
         i += sizeof(uint32_t);
         break;
@@ -24,6 +24,8 @@
 #ifndef RTLIB_SUBSEQUENCE_HH_
 #define RTLIB_SUBSEQUENCE_HH_
 
+#include <cassert>
+#include <limits>
 #include <ostream>
 
 #include "sequence.hh"
@@ -45,6 +47,28 @@ class Basic_Subsequence {
 #endif
 
  public:
+#ifdef COMPACT_SUBSEQUENCE
+    /*
+       gapc defines COMPACT_SUBSEQUENCE for single track programs: all
+       subsequences then are part of the one input sequence, which the
+       generated init() sets here, i.e. an object only consists of the
+       two indices and tabulated answers that contain subsequences are
+       trivially copyable; empty subsequences are marked by i == EMPTY
+    */
+    static const Basic_Sequence<alphabet, pos_type> *seq;
+    pos_type i;
+    pos_type j;
+
+    static constexpr pos_type EMPTY = std::numeric_limits<pos_type>::max();
+
+    Basic_Subsequence() : i(EMPTY), j(EMPTY) {}
+
+    Basic_Subsequence(const Basic_Sequence<alphabet, pos_type> &s,
+        pos_type a, pos_type b)
+      : i(a), j(b) {
+      assert(&s == seq);
+    }
+#else
     const Basic_Sequence<alphabet, pos_type> *seq;
     pos_type i;
     pos_type j;
@@ -55,6 +79,7 @@ class Basic_Subsequence {
         pos_type a, pos_type b)
       : seq(&s), i(a), j(b) {
     }
+#endif
 
     alphabet &front() {
       assert(seq);
@@ -70,6 +95,15 @@ class Basic_Subsequence {
       return (*seq)[j-1];
     }
 
+#ifdef COMPACT_SUBSEQUENCE
+    void empty() {
+      i = j = EMPTY;
+    }
+
+    bool isEmpty() const {
+      return i == EMPTY;
+    }
+#else
     void empty() {
       seq = NULL;
     }
@@ -77,6 +111,7 @@ class Basic_Subsequence {
     bool isEmpty() const {
       return !seq;
     }
+#endif
 
     pos_type size() const {
       return j-i;
@@ -97,6 +132,12 @@ class Basic_Subsequence {
     const_iterator end() const { assert(seq); return seq->seq+j; }
 };
 
+#ifdef COMPACT_SUBSEQUENCE
+template<typename alphabet, typename pos_type>
+const Basic_Sequence<alphabet, pos_type>
+  *Basic_Subsequence<alphabet, pos_type>::seq = NULL;
+#endif
+
 typedef Basic_Subsequence<> Subsequence;
 
 template<typename alphabet, typename pos_type>
@@ -0,0 +1,82 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+/*
+ * Table usage counters for profile guided table design. If the generated
+ * code is compiled with -DTABLE_PROFILE, every table counts its lookups
+ * (get), its computed cells (set) and the calls of its non-terminal that
+ * are answered from the table (hits, counted by the generated non-terminal
+ * functions), and the generated main writes them to the file named by the
+ * environment variable GAPC_TABLE_PROFILE (default: table.prof), which can
+ * be passed to gapc --table-profile.
+ * The counters are not synchronized, i.e. profile single threaded runs.
+ */
+
+#ifndef RTLIB_TABLE_PROFILE_HH_
+#define RTLIB_TABLE_PROFILE_HH_
+
+#ifdef TABLE_PROFILE
+
+#include <cstdint>
+#include <cstdlib>
+#include <ostream>
+
+namespace gapc {
+
+struct Table_Profile {
+  uint64_t gets;
+  uint64_t hits;
+  uint64_t sets;
+
+  Table_Profile() : gets(0), hits(0), sets(0) {}
+
+  void put(std::ostream &o, const char *nt, uint64_t cells,
+           uint64_t cell_bytes) const {
+    o << "nt " << nt << " gets " << gets << " hits " << hits << " sets "
+      << sets << " cells " << cells << " bytes " << cells * cell_bytes
+      << '\n';
+  }
+};
+
+inline const char *table_profile_file() {
+  const char *f = std::getenv("GAPC_TABLE_PROFILE");
+  return f ? f : "table.prof";
+}
+
+}  // namespace gapc
+
+#define TABLE_PROFILE_GET() ++profile.gets
+#define TABLE_PROFILE_SET() ++profile.sets
+#define TABLE_PROFILE_HIT(t) ++(t).profile.hits
+#define TABLE_PROFILE_HITS(t, n) (t).profile.hits += (n)
+
+#else
+
+#define TABLE_PROFILE_GET()
+#define TABLE_PROFILE_SET()
+#define TABLE_PROFILE_HIT(t)
+#define TABLE_PROFILE_HITS(t, n)
+
+#endif
+
+#endif  // RTLIB_TABLE_PROFILE_HH_
@@ -26,6 +26,7 @@
 #define RTLIB_TERMINAL_HH_
 
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <limits>
 #include <cmath>
@@ -66,47 +67,60 @@ inline Rope CONST_ROPE(Sequence &seq, pos_type i, pos_type j, const char *d) {
 template<typename pos_type>
 inline int INT(Sequence &seq, pos_type i, pos_type j) {
   assert(i < j);
-  int result = 0;
-  for (pos_type a = i; a < j; a++) {
-    if (seq[a] < '0' || seq[a] > '9') {
-      int r;
-      empty(r);
-      return r;
-    }
-    result = result * 10 + (seq[a] - '0');
+  const Numeric_Lex &lex = seq.numeric_lex();
+  if (lex.digits(i) < j - i) {
+    int r;
+    empty(r);
+    return r;
   }
-  return result;
+  // wraps around like the digit by digit evaluation would
+  return static_cast<int>(static_cast<uint32_t>(lex.int_value(i, j)));
 }
 
 template<typename pos_type>
 inline float FLOAT(Sequence &seq, pos_type i, pos_type j) {
   assert(i < j);
-  float result = 0;
-  bool saw_exponent = false;
+  const Numeric_Lex &lex = seq.numeric_lex();
+  if (lex.number_chars(i) < j - i) {
+    float r;
+    empty(r);
+    return r;
+  }
+  size_t dots = lex.dots(i, j);
+  size_t digits = (j - i) - dots;
   int exponent = 0;
+  if (dots) {
+    // digits right of the first '.'
+    exponent = (j - lex.next_dot(i) - 1) - (dots - 1);
+  }
+  // powers of ten up to 10^22 are exact doubles
+  static const double pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+  double div = exponent <= 22 ? pow10[exponent] : pow(10, exponent);
+
+  // below 2^24 all digit by digit float sums below are exact, thus
+  // the integer value gives the same float
+  if (digits <= 19) {
+    uint64_t v = lex.digits_value(i, j);
+    if (v < (uint64_t(1) << std::numeric_limits<float>::digits)) {
+      float result = static_cast<float>(v);
+      result = result / div;
+      return result;
+    }
+  }
 
-  // iterate through characters and return empty if char is neither . nor digit
-  // if char is '.': start incrementing the exponent, i.e. count the number
-  // of digits right of '.' and skip increasing result for now
+  // otherwise combine the digits one by one, skipping the '.'
+  float result = 0;
   for (pos_type a = i; a < j; a++) {
-    if (seq[a] == '.') {
-      saw_exponent = true;
-    } else {
-      if (seq[a] < '0' || seq[a] > '9') {
-        float r;
-        empty(r);
-        return r;
-      }
-      if (saw_exponent) {
-        ++exponent;
-      }
+    if (seq[a] != '.') {
       result = result * 10 + (seq[a] - '0');
     }
   }
 
   // after all digits have been parsed and combined in one large int value
   // devide result by 10^exponent to get real float
-  result = result / pow(10, exponent);
+  result = result / div;
   return result;
 }
 
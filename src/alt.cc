@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <sstream>
 #include <vector>
 #include <utility>
 
@@ -68,7 +69,8 @@ Alt::Base::~Base() {
 
 Alt::Simple::Simple(std::string *n, const Loc &l)
   :  Base(SIMPLE, l), is_terminal_(false),
-    name(n), decl(NULL), guards(NULL), inner_code(0) {
+    name(n), decl(NULL), split_reduce_(false), split_max_(false),
+    split_row_(NULL), split_column_(NULL), guards(NULL), inner_code(0) {
   hashtable<std::string, Fn_Decl*>::iterator j = Fn_Decl::builtins.find(*name);
   if (j != Fn_Decl::builtins.end()) {
     is_terminal_ = true;
@@ -1913,6 +1915,200 @@ std::list<Statement::Base*> *Alt::Simple::add_guards(
   return stmts;
 }
 
+#include "symbol.hh"
+#include "algebra.hh"
+#include "product.hh"
+
+// the minimum, maximum or sum choice function of nt, whose answer list
+// AST::optimize_choice reduces to a scalar, or NULL
+static Fn_Def *scalar_choice_fn(Algebra &algebra, Symbol::NT &nt) {
+  if (!nt.eval_fn) {
+    return NULL;
+  }
+  hashtable<std::string, Fn_Def*>::iterator i =
+    algebra.choice_fns.find(*nt.eval_fn);
+  if (i == algebra.choice_fns.end() ||
+      i->second->choice_mode() == Mode::KSCORING) {
+    return NULL;
+  }
+  switch (i->second->choice_fn_type()) {
+    case Expr::Fn_Call::MINIMUM :
+    case Expr::Fn_Call::MAXIMUM :
+    case Expr::Fn_Call::SUM :
+      return i->second;
+    default :
+      return NULL;
+  }
+}
+
+static std::string index_str(const Expr::Base *e) {
+  std::ostringstream o;
+  o << *e;
+  return o.str();
+}
+
+// the tabulated NT of a split operand with the indices (left, right)
+static Symbol::NT *split_operand(
+    Algebra &algebra, Fn_Arg::Base *arg, ::Type::Base *type,
+    const std::string &left, const std::string &right) {
+  if (!arg->is(Fn_Arg::ALT)) {
+    return NULL;
+  }
+  Alt::Base *alt = dynamic_cast<Fn_Arg::Alt*>(arg)->alt;
+  if (!alt->is(Alt::LINK) || alt->is_filtered() ||
+      !alt->multi_filter.empty()) {
+    return NULL;
+  }
+  Alt::Link *link = dynamic_cast<Alt::Link*>(alt);
+  Symbol::NT *nt = dynamic_cast<Symbol::NT*>(link->nt);
+  if (!nt || link->is_explicit() || !link->get_ntparas().empty() ||
+      !nt->is_tabulated() || nt->tracks() != 1 || nt->soa_table() ||
+      nt->fixed_table()) {
+    return NULL;
+  }
+  // the layout of Tablegen::offset_quad, which column() and row() of
+  // the Table_Decl address
+  const Table &table = nt->tables().front();
+  if (table.type() != Table::QUADRATIC || table.bounded() ||
+      table.delete_left_index() || table.delete_right_index()) {
+    return NULL;
+  }
+  // one answer per cell
+  ::Type::Base *t = nt->data_type()->simple();
+  if (t->is(::Type::LIST)) {
+    if (!scalar_choice_fn(algebra, *nt)) {
+      return NULL;
+    }
+    t = dynamic_cast< ::Type::List*>(t)->of->simple();
+  }
+  if (!t->is_eq(*type)) {
+    return NULL;
+  }
+  if (index_str(link->get_left_index(0)) != left ||
+      index_str(link->get_right_index(0)) != right) {
+    return NULL;
+  }
+  return nt;
+}
+
+
+bool Alt::Simple::init_split_reduce(AST &ast, Symbol::NT &lhs) {
+  split_reduce_ = false;
+  if (!ast.cyk() || ast.window_mode || ast.banded || ast.linear_space ||
+      ast.checkpoint || ast.outside_generation() || !ast.instance_ ||
+      !ast.instance_->product->is(Product::SINGLE)) {
+    return false;
+  }
+  if (!top_level || is_partof_outside() || tracks_ != 1 ||
+      adp_specialization != ADP_Mode::STANDARD || is_filtered() ||
+      !multi_filter.empty() || has_index_overlay() || !ntparas.empty() ||
+      loops.size() != 1 || args.size() != 2) {
+    return false;
+  }
+  Algebra &algebra = *ast.instance_->product->algebra();
+  Fn_Def *choice = scalar_choice_fn(algebra, lhs);
+  if (!choice || choice->choice_fn_type() == Expr::Fn_Call::SUM) {
+    return false;
+  }
+
+  // f(a, b) = a + b over int, float or double
+  hashtable<std::string, Fn_Def*>::iterator i = algebra.fns.find(*name);
+  if (i == algebra.fns.end()) {
+    return false;
+  }
+  Fn_Def *fn = i->second;
+  ::Type::Base *type = fn->return_type->simple();
+  if (!type->is(::Type::INT) && !type->is(::Type::FLOAT) &&
+      !type->is(::Type::SINGLE)) {
+    return false;
+  }
+  if (fn->names.size() != 2 || fn->types.size() != 2 ||
+      !fn->types.front()->simple()->is_eq(*type) ||
+      !fn->types.back()->simple()->is_eq(*type) ||
+      fn->stmts.size() != 1 || !fn->stmts.front()->is(Statement::RETURN)) {
+    return false;
+  }
+  Expr::Base *e = dynamic_cast<Statement::Return*>(fn->stmts.front())->expr;
+  if (!e || !e->is(Expr::PLUS)) {
+    return false;
+  }
+  Expr::Two *plus = dynamic_cast<Expr::Two*>(e);
+  if (!plus->left()->is(Expr::VACC) || !plus->right()->is(Expr::VACC) ||
+      *dynamic_cast<Expr::Vacc*>(plus->left())->name() !=
+      *fn->names.front() ||
+      *dynamic_cast<Expr::Vacc*>(plus->right())->name() !=
+      *fn->names.back()) {
+    return false;
+  }
+
+  // i <= k <= hi, without a maximal yield size bound
+  Statement::For *loop = loops.front();
+  std::string k(*loop->var_decl->name);
+  if (!loop->cond->is(Expr::LESS_EQ) ||
+      index_str(dynamic_cast<Expr::Less_Eq*>(loop->cond)->lhs) != k) {
+    return false;
+  }
+  std::string left(index_str(left_indices.front()));
+  std::string right(index_str(right_indices.front()));
+  Symbol::NT *row = split_operand(algebra, args.front(), type, left, k);
+  Symbol::NT *column = split_operand(algebra, args.back(), type, k, right);
+  if (!row || !column) {
+    return false;
+  }
+
+  split_reduce_ = true;
+  split_max_ = choice->choice_fn_type() == Expr::Fn_Call::MAXIMUM;
+  split_row_ = row;
+  split_column_ = column;
+  row->set_row_access(true);
+  column->set_column_access(true);
+  return true;
+}
+
+
+void Alt::Simple::codegen_split_reduce(std::list<Statement::Base*> &stmts) {
+  Statement::For *loop = loops.front();
+  Expr::Base *hi = dynamic_cast<Expr::Less_Eq*>(loop->cond)->rhs;
+
+  Expr::Fn_Call *r = new Expr::Fn_Call(
+    new std::string(*split_row_->name + "_table.row"));
+  r->add_arg(left_indices.front());
+  Expr::Fn_Call *c = new Expr::Fn_Call(
+    new std::string(*split_column_->name + "_table.column"));
+  c->add_arg(right_indices.front());
+
+  Expr::Fn_Call *f = new Expr::Fn_Call(new std::string(
+    split_max_ ? "split_max_plus" : "split_min_plus"));
+  f->add_arg(r);
+  f->add_arg(c);
+  f->add_arg(loop->var_decl->rhs);
+  f->add_arg(hi->plus(new Expr::Const(1)));
+
+  // the reduction reads the operand cells of all split points without
+  // calling the non-terminals
+  Expr::Base *n = hi->plus(new Expr::Const(1))->minus(loop->var_decl->rhs);
+  Symbol::NT *nts[] = { split_row_, split_column_ };
+  for (size_t i = 0; i < 2; ++i) {
+    Statement::Fn_Call *hits = new Statement::Fn_Call("TABLE_PROFILE_HITS");
+    hits->add_arg(new std::string(*nts[i]->name + "_table"));
+    hits->add_arg(n);
+    stmts.push_back(hits);
+  }
+
+  Statement::Var_Decl *ans = new Statement::Var_Decl(
+    decl->return_type, new std::string("ans"), f);
+  stmts.push_back(ans);
+
+  Expr::Fn_Call *not_empty = new Expr::Fn_Call(Expr::Fn_Call::NOT_EMPTY);
+  not_empty->add_arg(*ans);
+  Statement::Fn_Call *push = new Statement::Fn_Call(
+    Statement::Fn_Call::PUSH_BACK);
+  push->add_arg(*ret_decl);
+  push->add_arg(*ans);
+  stmts.push_back(new Statement::If(not_empty, push));
+}
+
+
 void Alt::Simple::codegen(AST &ast) {
   // std::cout << "-----------Simple IN" << std::endl;
 
@@ -1942,6 +2138,11 @@ void Alt::Simple::codegen(AST &ast) {
 
   init_filter_guards(ast);
 
+  if (split_reduce_) {
+    codegen_split_reduce(*stmts);
+    return;
+  }
+
         // answer_list is always set when return type is a list
         // see symbol set_ret_decl_rhs
         if (nullary && answer_list && !disabled_spec) {
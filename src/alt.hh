@@ -434,6 +434,14 @@ class Simple : public Base {
   std::list<Statement::Foreach *> foreach_loops;
   std::list<Statement::Base*> body_stmts;
 
+  // set by init_split_reduce(): the split loop is a min/max-plus
+  // reduction over a row of split_row_ and a column of split_column_
+  bool split_reduce_;
+  bool split_max_;
+  Symbol::NT *split_row_;
+  Symbol::NT *split_column_;
+  void codegen_split_reduce(std::list<Statement::Base*> &stmts);
+
   Statement::If *guards;
   Statement::If *guards_outside;
   void ret_decl_empty_block(Statement::If *stmt);
@@ -477,6 +485,11 @@ class Simple : public Base {
   void init_outside_guards();
   std::list<Statement::Base*> *add_guards(
       std::list<Statement::Base*> *stmts, bool add_outside_guards);
+  // true, if this alternative of lhs is lhs(i,j) = f(T(i,k), U(k,j)) with
+  // f(a,b) = a + b, one split loop over k and a minimum or maximum choice
+  // function in CYK code; codegen() then replaces the loop with a fused
+  // split_min_plus/split_max_plus call of rtlib/split_reduce.hh
+  bool init_split_reduce(AST &ast, Symbol::NT &lhs);
   void codegen(AST &ast);
 
   void print_dot_edge(std::ostream &out, Symbol::NT &nt);
@@ -810,6 +823,11 @@ class Multi : public Base {
     return list.size();
   }
 
+  // the single-track alternatives of the tracks
+  const std::list<Base*> &components() const {
+    return list;
+  }
+
 
   bool init_links(Grammar &grammar);
 
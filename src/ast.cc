@@ -65,6 +65,7 @@ AST::AST()
     original_product(0),
     char_type(0),
     outside_nt_list(nullptr),
+    row_depth(0),
     checkpoint(nullptr) {
   Type::add_predefined(types);
 }
@@ -295,8 +296,8 @@ void AST::codegen() {
 }
 
 
-void AST::print_code(Printer::Base &out) {
-  grammar()->print_code(out);
+void AST::print_code(Printer::Base &out, size_t part, size_t parts) {
+  grammar()->print_code(out, part, parts);
 }
 
 
@@ -942,6 +943,42 @@ void AST::set_window_mode(bool w) {
 }
 
 
+void AST::set_banded(bool b) {
+  if (!b)
+    return;
+  if (grammar()->axiom->tracks() < 2)
+    throw LogError("--band needs a multi-track grammar.");
+  if (outside_generation())
+    throw LogError("--band is not available for outside grammars.");
+
+  banded = Bool(b);
+}
+
+
+void AST::set_linear_space(bool b) {
+  if (!b)
+    return;
+  if (grammar()->axiom->tracks() < 2)
+    throw LogError("--linear-space needs a multi-track grammar.");
+  if (outside_generation())
+    throw LogError("--linear-space is not available for outside grammars.");
+  size_t d = 0;
+  if (!grammar()->row_distance(d))
+    throw LogError("--linear-space needs tables of all tracks that are "
+                   "linear in track 0 with a free left index, whose rows "
+                   "depend on a bounded number of following rows.");
+
+  linear_space = Bool(b);
+  row_depth = d;
+}
+
+
+void AST::set_compact_subseq(bool c) {
+  // with several tracks, the sequence of a subsequence is not implied
+  compact_subseq = Bool(c && grammar()->axiom->tracks() == 1);
+}
+
+
 bool AST::grammar_defined(const std::string &n) const {
   assert(grammars_);
   for (std::list<Grammar*>::iterator i = grammars_->begin();
@@ -203,7 +203,9 @@ class AST {
 
   void codegen();
 
-  void print_code(Printer::Base &out);
+  // prints the code of every parts-th non-terminal, starting with
+  // the part-th one (see --split-code)
+  void print_code(Printer::Base &out, size_t part = 0, size_t parts = 1);
 
   void derive_roles();
 
@@ -295,6 +297,23 @@ class AST {
   Bool window_mode;
   void set_window_mode(bool w);
 
+  // gapc --band, tables of multi-track NTs are restricted to a band of
+  // cells around the diagonal of track 0 and the other tracks
+  Bool banded;
+  void set_banded(bool b);
+
+  // gapc --linear-space, only blocks of rows, i.e. of cells with the same
+  // left index of track 0, of the tables are stored, see
+  // rtlib/row_table.hh; each row depends on the next row_depth rows only
+  Bool linear_space;
+  size_t row_depth;
+  void set_linear_space(bool b);
+
+  // Subsequence objects only consist of their indices, see
+  // rtlib/subsequence.hh
+  Bool compact_subseq;
+  void set_compact_subseq(bool c);
+
   Bool kbest;
 
   std::list<std::pair<Filter*, Expr::Fn_Call*> > sf_filter_code;
@@ -107,7 +107,8 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
         if (type == Type::Type::STRING) {
           strings = true;
         } else if (type == Type::Type::SUBSEQ) {
-          subseq = true;
+          // compact subsequences don't store a pointer to restore
+          subseq = !compact_subseq;
         } else if (type == Type::Type::EXTERNAL) {
           // only allow external type "Rope" and some fold-grammars types
           Type::External *e = dynamic_cast<Type::External*>(t);
@@ -329,9 +330,16 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
   */
   bool cyk;
 
+  /*
+     true if Subsequence objects only consist of their indices
+     (COMPACT_SUBSEQUENCE), in which case there are no pointers to the
+     input sequence to restore after deserialization
+  */
+  bool compact_subseq;
+
   Checkpoint() : list_ref(false), strings(false),
                  subseq(false), user_def(false),
-                 is_buddy(false), cyk(false) {}
+                 is_buddy(false), cyk(false), compact_subseq(false) {}
 
   bool is_supported(const nt_tables &tables) {
      // check datatypes of every table (all tables must have supported type)
@@ -403,6 +411,7 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      stream << "extern \"C\" {" << endl;
      stream << indent() << "#include <unistd.h>" << endl;
      stream << indent() << "#include <sys/resource.h>" << endl;
+     stream << indent() << "#include <sys/wait.h>" << endl;
      stream << "}" << endl;
      stream << "#include \"boost/serialization/vector.hpp\"" << endl;
      stream << "#include \"boost/serialization/utility.hpp\"" << endl;
@@ -414,14 +423,12 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      stream << "#include <ctime>" << endl;
      stream << "#include <unordered_map>" << endl;
      stream << "#include <algorithm>" << endl;
+     stream << "#include \"rtlib/compressed_archive.hh\"" << endl;
      if (cyk) {
+       stream << "#include \"rtlib/delta_archive.hh\"" << endl;
        stream << "#include \"boost/archive/text_oarchive.hpp\"" << endl;
        stream << "#include \"boost/archive/text_iarchive.hpp\"" << endl;
-       stream << "#ifdef _OPENMP" << endl;
-       stream << "#include \"rtlib/fair_shared_mutex.hh\"" << endl;
-       stream << "#else" << endl;
-       stream << "#include \"rtlib/fair_mutex.hh\"" << endl;
-       stream << "#endif" << endl;
+       stream << "#include \"rtlib/checkpoint_gate.hh\"" << endl;
      } else {
        stream << "#include <mutex>" << endl;
      }
@@ -917,11 +924,31 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
   void archive(Printer::Base &stream) {
      inc_indent(); inc_indent();
      stream << indent();
-     stream << "void archive(const std::string &tname) {" << endl;
+     stream << "bool archive(const std::string &tname) {" << endl;
      inc_indent();
      stream << indent() << "// save the DP table/array to disk" << endl;
      stream << indent() << "try {" << endl;
      inc_indent();
+     if (cyk) {
+       stream << indent() << "// only append the cells that were computed "
+              << "since the last archive," << endl
+              << indent() << "// if the table type can be dumped as raw "
+              << "memory" << endl;
+       stream << indent() << "if (gapc::append_delta(out_table_path.string(), "
+              << "array, dirty," << endl
+              << indent() << "                       "
+              << "tabulated_vals_counter, compress_threads)) {" << endl;
+       inc_indent();
+       stream << indent() << "std::cerr << \"Info: Archived new cells of "
+              << "\\\"\" << tname << \"\\\" table into \"" << endl
+              << indent() << "          << out_table_path << \". Table is \" "
+              << "<< get_tabulated_vals_percentage()" << endl
+              << indent() << "          << \"% filled.\" << std::endl;"
+              << endl;
+       stream << indent() << "return true;" << endl;
+       dec_indent();
+       stream << indent() << "}" << endl;
+     }
      stream << indent() << "/* create temp archive and replace last archive "
             << "with new archive" << endl
             << indent() << "   once new archive has been created instead "
@@ -933,8 +960,10 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      stream << indent() << "if (!(array_fout.good())) {" << endl;
      stream << indent() << "  throw std::ofstream::failure(\"\");" << endl;
      stream << indent() << "}" << endl;
+     stream << indent() << "gapc::Compressed_Ostream array_zout(array_fout, "
+            << "compress_threads);" << endl;
      stream << indent() << "boost::archive::binary_oarchive "
-                            "array_out(array_fout);" << endl;
+                            "array_out(array_zout);" << endl;
      if (!cyk) {
        stream << indent() << "// lock the mutex so main thread can't "
             << "write during archiving" << endl;
@@ -945,6 +974,10 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
        stream << indent() << "array_out << array << tabulated_vals_counter;"
               << endl;
      }
+     stream << indent() << "array_zout.finish();" << endl;
+     stream << indent() << "if (!(array_zout.good())) {" << endl;
+     stream << indent() << "  throw std::ofstream::failure(\"\");" << endl;
+     stream << indent() << "}" << endl;
      stream << indent() << "array_fout.close();" << endl;
      stream << indent() << "boost::filesystem::rename(tmp_out_table_path, "
             << "out_table_path);" << endl;
@@ -953,6 +986,7 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
             << indent() << "          << \". Table is \" "
             << "<< get_tabulated_vals_percentage() << \"% filled.\" "
             << "<< std::endl;" << endl;
+     stream << indent() << "return true;" << endl;
      dec_indent();
      stream << indent() << "} catch (const std::ofstream::failure &e) {"
              << endl;
@@ -961,6 +995,7 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      stream << indent() << "            << \"Please ensure that the directory "
              << "exists and that you have write permissions "
              << "for this directory.\\n\";" << endl;
+     stream << indent() << "  return false;" << endl;
      stream << indent() << "} catch (const std::exception &e) {" << endl;
      inc_indent();
      stream << indent() << "std::time_t curr_time = std::time(nullptr);"
@@ -976,6 +1011,7 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
             << "<< formatted_interval << \".\\n\";" << endl;
      stream << indent() << "boost::filesystem::remove(tmp_out_table_path);"
             << endl;
+     stream << indent() << "return false;" << endl;
      dec_indent();
      stream << indent() << "}" << endl;
      dec_indent();
@@ -986,7 +1022,7 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
   void archive_cyk_indices(Printer::Base &stream, size_t n_tracks,
                            bool outside) {
      inc_indent();
-     stream << indent() << "void archive_cyk_indices() {" << endl;
+     stream << indent() << "bool archive_cyk_indices() {" << endl;
      inc_indent();
      stream << indent() << "// save the cyk loop indidces to disk" << endl;
      stream << indent() << "try {" << endl;
@@ -999,8 +1035,8 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      stream << indent() << "boost::archive::text_oarchive "
                             "array_out(array_fout);" << endl;
      for (size_t i = 0; i < n_tracks; i++) {
-       // since a mutex is locked before every loop iteration that prevents
-       // any archiving before it is unlocked again,
+       // since the loops hold the checkpoint gate during every iteration,
+       // which prevents any archiving before it is left again,
        // we can directly dump the indices without having to worry
        // about potentially incomplete iterations
        std::string suffix = "";
@@ -1049,6 +1085,7 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      stream << indent() << "std::cerr << \"Info: Archived cyk loop progress"
             << " into \" << out_cyk_path << \".\" "
             << "<< std::endl;" << endl;
+     stream << indent() << "return true;" << endl;
      dec_indent();
      stream << indent() << "} catch (const std::ofstream::failure &e) {"
              << endl;
@@ -1057,6 +1094,7 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      stream << indent() << "            << \"Please ensure that the directory "
              << "exists and that you have write permissions "
              << "for this directory.\\n\";" << endl;
+     stream << indent() << "  return false;" << endl;
      stream << indent() << "} catch (const std::exception &e) {" << endl;
      inc_indent();
      stream << indent() << "std::time_t curr_time = std::time(nullptr);"
@@ -1069,6 +1107,7 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
             << "Error trying to archive cyk loop progress.\\n\";" << endl;
      stream << indent() << "boost::filesystem::remove(tmp_out_cyk_path);"
             << endl;
+     stream << indent() << "return false;" << endl;
      dec_indent();
      stream << indent() << "}" << endl;
      dec_indent();
@@ -1165,6 +1204,35 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      dec_indent(); dec_indent();
   }
 
+  /*
+     helpers of the table classes for archive_snapshot: in regular mode
+     the table mutex is held across fork(), such that the child never
+     sees a half written cell; in cyk mode the loop gate already
+     guarantees that and the parent instead takes over the dirty blocks
+     of the delta archive, which the child is about to archive
+  */
+  void snapshot(Printer::Base &stream) {
+     inc_indent(); inc_indent();
+     if (!cyk) {
+       stream << indent() << "void lock_snapshot() {" << endl;
+       stream << indent() << "  m.lock();" << endl;
+       stream << indent() << "}" << endl << endl;
+       stream << indent() << "void unlock_snapshot() {" << endl;
+       stream << indent() << "  m.unlock();" << endl;
+       stream << indent() << "}" << endl << endl;
+     } else {
+       stream << indent() << "std::vector<unsigned char> take_dirty() {"
+              << endl;
+       stream << indent() << "  return dirty.take();" << endl;
+       stream << indent() << "}" << endl << endl;
+       stream << indent() << "void merge_dirty(const "
+              << "std::vector<unsigned char> &blocks) {" << endl;
+       stream << indent() << "  dirty.merge(blocks);" << endl;
+       stream << indent() << "}" << endl << endl;
+     }
+     dec_indent(); dec_indent();
+  }
+
   void get_table(Printer::Base &stream, const Type::Base &dtype) {
      inc_indent(); inc_indent();
      stream << indent();
@@ -1228,6 +1296,8 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      inc_indent(); inc_indent(); inc_indent();
      stream << indent() << "this->formatted_interval = formatted_interval;"
             << endl;
+     stream << indent() << "this->compress_threads = compress_threads;"
+            << endl;
      stream << indent() << "out_table_path = out_path / (file_prefix + \"_\" + "
             << "tname);" << endl;
      stream << indent() << "tmp_out_table_path = out_path / (file_prefix + "
@@ -1240,21 +1310,41 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      inc_indent();
      stream << indent() << "parse_checkpoint_log(tname, arg_string, in_path);"
             << endl << endl;
+     if (cyk) {
+       stream << indent() << "if (!gapc::load_delta(in_archive_path.string(), "
+              << "array," << endl
+              << indent() << "                       "
+              << "tabulated_vals_counter, compress_threads)) {" << endl;
+       inc_indent();
+     }
      stream << indent() << "std::ifstream array_fin(in_archive_path.c_str(), "
             << "std::ios::binary);" << endl;
      stream << indent() << "if (!(array_fin.good())) {" << endl;
      stream << indent() << "  throw std::ifstream::failure(\"\");" << endl;
      stream << indent() << "}" << endl;
+     stream << indent() << "gapc::Compressed_Istream array_zin(array_fin, "
+            << "compress_threads);" << endl;
      stream << indent() << "boost::archive::binary_iarchive "
-                            "array_in(array_fin);" << endl;
+                            "array_in(array_zin);" << endl;
      if (!cyk) {
        stream << indent() << "array_in >> array >> tabulated >> "
               << "tabulated_vals_counter;" << endl;
+       stream << indent() << "array_fin.close();" << endl << endl;
      } else  {
        stream << indent() << "array_in >> array >> tabulated_vals_counter;"
               << endl;
+       stream << indent() << "array_fin.close();" << endl;
+       dec_indent();
+       stream << indent() << "}" << endl;
+       stream << indent() << "// compact the restored table into the new "
+              << "archive, which the" << endl
+              << indent() << "// following checkpoints only append to"
+              << endl;
+       stream << indent() << "gapc::compact_delta(out_table_path.string(), "
+              << "array, tabulated_vals_counter," << endl
+              << indent() << "                    compress_threads);" << endl;
+       stream << indent() << "dirty.resize(array.size());" << endl << endl;
      }
-     stream << indent() << "array_fin.close();" << endl << endl;
      stream << indent() << "std::cerr << \"Info: Successfully loaded checkpoint"
             << " for \\\"\" << tname << \"\\\" table. \"" << endl;
      stream << indent() << "          << \"Will continue calculating from here."
@@ -1290,6 +1380,8 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      if (!cyk) {
        stream << indent() << "tabulated.clear();" << endl;
        stream << indent() << "tabulated.resize(newsize);" << endl;
+     } else {
+       stream << indent() << "dirty.resize(newsize);" << endl;
      }
      dec_indent();
      stream << indent() << "}" << endl << endl;
@@ -1303,13 +1395,7 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
             << "std::mutex &print_mutex" << endl;
      if (cyk) {
      stream << indent() << "                          "
-            << "#ifdef _OPENMP" << endl
-            << indent() << "                          "
-            << ", fair_shared_mutex &mutex" << endl
-            << indent() << "                          #else" << endl
-            << indent() << "                          "
-            << ", fair_mutex &mutex" << endl
-            << indent() << "                          #endif" << endl;
+            << ", gapc::Checkpoint_Gate &mutex" << endl;
      }
      stream << indent() << "                          ) {" << endl;
      inc_indent();
@@ -1334,14 +1420,14 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
             << "simultaneous logging to stdout" << endl;
      stream << indent() << "              "
             << "std::lock_guard<std::mutex> print_lock(print_mutex);" << endl;
+     stream << indent() << "              if (snapshot_archives) {" << endl;
+     stream << indent() << "                archive_snapshot("
+            << (cyk ? "mutex" : "") << ");" << endl;
+     stream << indent() << "                continue;" << endl;
+     stream << indent() << "              }" << endl;
      if (cyk) {
-       stream << indent() << "            #ifdef _OPENMP" << endl;
-       stream << indent() << "              "
-              << "std::lock_guard<fair_shared_mutex> lock(mutex);" << endl;
-       stream << indent() << "            #else" << endl;
        stream << indent() << "              "
-              << "std::lock_guard<fair_mutex> lock(mutex);" << endl;
-       stream << indent() << "            #endif" << endl;
+              << "std::lock_guard<gapc::Checkpoint_Gate> lock(mutex);" << endl;
      }
 
      for (auto i = tables.begin(); i != tables.end(); ++i) {
@@ -1362,6 +1448,115 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      dec_indent();
   }
 
+  /*
+     alternative to the archiving in archive_periodically: the tables are
+     archived by a forked child process, which sees a copy-on-write
+     snapshot of the tables at the time of the fork, such that the
+     calculations only pause for the fork() itself instead of
+     for writing all tables
+  */
+  void archive_snapshot(Printer::Base &stream, const nt_tables &tables) {
+     inc_indent();
+     stream << indent() << "void archive_snapshot(";
+     if (cyk) {
+       stream << "gapc::Checkpoint_Gate &mutex";
+     }
+     stream << ") {" << endl;
+     inc_indent();
+     stream << indent() << "pid_t pid;" << endl;
+     if (cyk) {
+       for (auto i = tables.begin(); i != tables.end(); ++i) {
+         const std::string &table_name = i->second->table_decl->name();
+         stream << indent() << "std::vector<unsigned char> " << table_name
+                << "_dirty;" << endl;
+       }
+     }
+     stream << indent() << "{" << endl;
+     inc_indent();
+     if (cyk) {
+       stream << indent() << "std::lock_guard<gapc::Checkpoint_Gate> "
+              << "lock(mutex);" << endl;
+     } else {
+       for (auto i = tables.begin(); i != tables.end(); ++i) {
+         stream << indent() << i->second->table_decl->name()
+                << ".lock_snapshot();" << endl;
+       }
+     }
+     stream << indent() << "pid = fork();" << endl;
+     stream << indent() << "if (pid == 0) {" << endl;
+     inc_indent();
+     stream << indent() << "// the child only consists of this thread; it "
+            << "archives the tables" << endl
+            << indent() << "// as they were at the fork and exits without "
+            << "running the" << endl
+            << indent() << "// destructors of the parent's objects" << endl;
+     if (!cyk) {
+       for (auto i = tables.begin(); i != tables.end(); ++i) {
+         stream << indent() << i->second->table_decl->name()
+                << ".unlock_snapshot();" << endl;
+       }
+     }
+     stream << indent() << "bool ok = true;" << endl;
+     for (auto i = tables.begin(); i != tables.end(); ++i) {
+       const std::string &table_name = i->second->table_decl->name();
+       stream << indent() << "ok = " << table_name << ".archive(\""
+              << table_name << "\") && ok;" << endl;
+     }
+     if (cyk) {
+       stream << indent() << "ok = archive_cyk_indices() && ok;" << endl;
+     }
+     stream << indent() << "std::cerr.flush();" << endl;
+     stream << indent() << "_exit(ok ? 0 : 1);" << endl;
+     dec_indent();
+     stream << indent() << "}" << endl;
+     if (cyk) {
+       stream << indent() << "if (pid > 0) {" << endl;
+       inc_indent();
+       for (auto i = tables.begin(); i != tables.end(); ++i) {
+         const std::string &table_name = i->second->table_decl->name();
+         stream << indent() << table_name << "_dirty = " << table_name
+                << ".take_dirty();" << endl;
+       }
+       dec_indent();
+       stream << indent() << "}" << endl;
+     } else {
+       for (auto i = tables.begin(); i != tables.end(); ++i) {
+         stream << indent() << i->second->table_decl->name()
+                << ".unlock_snapshot();" << endl;
+       }
+     }
+     dec_indent();
+     stream << indent() << "}" << endl;
+     stream << indent() << "if (pid < 0) {" << endl;
+     stream << indent() << "  std::cerr << \"Error: couldn't fork the "
+            << "archiving process. \"" << endl;
+     stream << indent() << "            << \"Will retry with the next "
+            << "checkpoint.\\n\";" << endl;
+     stream << indent() << "  return;" << endl;
+     stream << indent() << "}" << endl;
+     stream << indent() << "int status = 0;" << endl;
+     stream << indent() << "if (waitpid(pid, &status, 0) == pid && "
+            << "WIFEXITED(status) &&" << endl;
+     stream << indent() << "    WEXITSTATUS(status) == 0) {" << endl;
+     stream << indent() << "  update_checkpoint_log();" << endl;
+     if (cyk) {
+       stream << indent() << "} else {" << endl;
+       inc_indent();
+       stream << indent() << "// archive the cells of the failed snapshot "
+              << "with the next one" << endl;
+       for (auto i = tables.begin(); i != tables.end(); ++i) {
+         const std::string &table_name = i->second->table_decl->name();
+         stream << indent() << table_name << ".merge_dirty(" << table_name
+                << "_dirty);" << endl;
+       }
+       dec_indent();
+     }
+     stream << indent() << "}" << endl;
+     dec_indent();
+     stream << indent() << "}" << endl << endl;
+     dec_indent();
+  }
+
   void remove_tables(Printer::Base &stream, const nt_tables &tables) {
      inc_indent();
      stream << indent() << "void remove_tables() {" << endl;
@@ -1438,13 +1633,21 @@ SUPPORTED_EXTERNAL_TYPES = {"Rope", "answer_pknot_mfe", "pktype",
      stream << indent() << "    std::strcmp(argv[i], \"--checkpointInput\")"
             << " == 0 ||" << endl;
      stream << indent() << "    std::strcmp(argv[i], \"--checkpointInterval\")"
+            << " == 0 ||" << endl;
+     stream << indent() << "    std::strcmp(argv[i], \"-Z\")"
+            << " == 0 ||" << endl;
+     stream << indent() << "    std::strcmp(argv[i], \"--compressArchives\")"
             << " == 0) {" << endl;
      inc_indent();
      stream << indent() << "i += 2;" << endl;
      dec_indent();
      stream << indent() << "} else if (std::strcmp(argv[i], \"--keepArchives\")"
             << " == 0 ||" << endl;
-     stream << indent() << "           std::strcmp(argv[i], \"-K\") == 0) {"
+     stream << indent() << "           std::strcmp(argv[i], \"-K\") == 0 ||"
+            << endl;
+     stream << indent() << "           std::strcmp(argv[i], "
+            << "\"--snapshotArchives\") == 0 ||" << endl;
+     stream << indent() << "           std::strcmp(argv[i], \"-S\") == 0) {"
             << endl;
      inc_indent();
      stream << indent() << "++i;" << endl;
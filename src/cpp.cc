@@ -622,6 +622,9 @@ void Printer::Cpp::print(const std::list<Para_Decl::Base*> &paras) {
 void Printer::Cpp::print(const Fn_Def &fn_def) {
   if (fn_def.disabled())
     return;
+  if (templates_only &&
+      !(fn_def.choice_fn && fn_def.types.front()->is(Type::RANGE)))
+    return;
 
   if (fn_def.adaptor)
     stream << *fn_def.adaptor;
@@ -1097,12 +1100,34 @@ void Printer::Cpp::print(const Statement::Table_Decl &t) {
     stream << indent() << "unsigned wsize;" << endl;
     stream << indent() << "unsigned winc;" << endl;
   }
+  if (t.band()) {
+    stream << indent() << "unsigned band;" << endl;
+  }
 
   print_most_decl(t.nt());
 
-  stream << indent() << "std::vector<" << dtype << "> array;" << endl;
+  if (t.sparse()) {
+    stream << indent() << "Table::Sparse<" << dtype << "> array;" << endl;
+  } else if (t.rows()) {
+    stream << indent() << "Table::Rows<" << dtype << "> array;" << endl;
+  } else if (t.soa()) {
+    stream << indent() << "Table::SoA<" << dtype << "> array;" << endl;
+  } else if (t.fixed_cells()) {
+    stream << indent() << "Table::Fixed<" << dtype << ", " << t.fixed_cells()
+           << "> array;" << endl;
+  } else {
+    stream << indent() << "std::vector<" << dtype << "> array;" << endl;
+  }
+  if (t.row_access()) {
+    stream << indent() << "std::vector<" << dtype << "> transposed;" << endl;
+  }
   if  (!cyk) {
-    stream << indent() << "std::vector<bool> tabulated;" << endl;
+    if (t.fixed_cells()) {
+      stream << indent() << "Table::Fixed<unsigned char, " << t.fixed_cells()
+             << "> tabulated;" << endl;
+    } else {
+      stream << indent() << "std::vector<bool> tabulated;" << endl;
+    }
   }
   print(ns);
   stream << indent() << dtype << " zero;" << endl;
@@ -1113,8 +1138,12 @@ void Printer::Cpp::print(const Statement::Table_Decl &t) {
     stream << indent() << "boost::filesystem::path in_archive_path;" << endl;
     if (!cyk) {
       stream << indent() << "std::mutex m;" << endl;
+    } else {
+      // cells written since the last (delta) archive
+      stream << indent() << "gapc::Dirty_Blocks dirty;" << endl;
     }
     stream << indent() << "std::string formatted_interval;" << endl;
+    stream << indent() << "unsigned compress_threads;" << endl;
     stream << indent() << "size_t tabulated_vals_counter = 0;" << endl;
     stream << endl;
   }
@@ -1134,6 +1163,7 @@ void Printer::Cpp::print(const Statement::Table_Decl &t) {
   if (checkpoint) {
     ast->checkpoint->archive(stream);
     ast->checkpoint->remove(stream);
+    ast->checkpoint->snapshot(stream);
     ast->checkpoint->get_out_table_path(stream);
     ast->checkpoint->get_tabulated_vals_percentage(stream);
     ast->checkpoint->parse_checkpoint_log(stream, false);
@@ -1153,6 +1183,12 @@ void Printer::Cpp::print(const Statement::Table_Decl &t) {
   if (wmode) {
     stream << ", unsigned wsize_, unsigned winc_";
   }
+  if (t.band()) {
+    stream << ", unsigned band_";
+  }
+  if (t.rows()) {
+    stream << ", Table::Row_Blocks &row_blocks";
+  }
 
   stream << ", const std::string &tname";
   if (checkpoint) {
@@ -1160,7 +1196,8 @@ void Printer::Cpp::print(const Statement::Table_Decl &t) {
            << indent() << "          const boost::filesystem::path &in_path, "
            << "const std::string &arg_string," << endl
            << indent() << "          const std::string &formatted_interval, "
-           << "const std::string &file_prefix";
+           << "const std::string &file_prefix," << endl
+           << indent() << "          unsigned compress_threads";
   }
   stream << ") {" << endl;
   inc_indent();
@@ -1178,6 +1215,9 @@ void Printer::Cpp::print(const Statement::Table_Decl &t) {
     stream << indent() << "winc = winc_;" << endl;
     stream << indent() << "t_0_right_most = wsize;" << endl;
   }
+  if (t.band()) {
+    stream << indent() << "band = band_;" << endl;
+  }
 
   stream << indent() << ptype << " newsize = size(";
   stream << ");" << endl;
@@ -1189,9 +1229,18 @@ void Printer::Cpp::print(const Statement::Table_Decl &t) {
 
   if (checkpoint) {
     ast->checkpoint->init(stream);
+  } else if (t.rows()) {
+    stream << indent() << "array.init(row_blocks, newsize);" << endl;
+  } else if (t.row_access() || t.column_access()) {
+    // the split reductions read the cells outside of the yield sizes,
+    // which get() maps to zero, directly
+    stream << indent() << "array.assign(newsize, zero);" << endl;
   } else {
     stream << indent() << "array.resize(newsize);" << endl;
   }
+  if (t.row_access()) {
+    stream << indent() << "transposed.assign(newsize, zero);" << endl;
+  }
 
   dec_indent();
   stream << indent() << "}" << endl << endl;
@@ -1214,8 +1263,45 @@ void Printer::Cpp::print(const Statement::Table_Decl &t) {
 
   stream << t.fn_get_tab() << endl;
 
+  // the cells (i, k) and (k, j) of a quadratic table, indexed by k
+  std::ostringstream si, sj, sn;
+  si << "t_" << t.nt().track_pos() << "_i";
+  sj << "t_" << t.nt().track_pos() << "_j";
+  sn << "t_" << t.nt().track_pos() << "_n";
+  if (t.row_access()) {
+    stream << indent() << "const " << dtype << " *row(" << ptype << ' '
+           << si.str() << ") const {" << endl;
+    inc_indent();
+    stream << indent() << "return transposed.data() + (" << si.str()
+           << " * ((2 * " << sn.str() << ") - " << si.str() << " + 1)) / 2;"
+           << endl;
+    dec_indent();
+    stream << indent() << "}" << endl << endl;
+  }
+  if (t.column_access()) {
+    stream << indent() << "const " << dtype << " *column(" << ptype << ' '
+           << sj.str() << ") const {" << endl;
+    inc_indent();
+    stream << indent() << "return array.data() + (" << sj.str() << " * ("
+           << sj.str() << " + 1)) / 2;" << endl;
+    dec_indent();
+    stream << indent() << "}" << endl << endl;
+  }
+
   stream << t.fn_tab();
 
+  stream << endl << "#ifdef TABLE_PROFILE" << endl;
+  stream << indent() << "gapc::Table_Profile profile;" << endl << endl;
+  stream << indent()
+         << "void put_profile(std::ostream &o, const char *nt) {"
+         << endl;
+  inc_indent();
+  stream << indent() << "profile.put(o, nt, size(), sizeof(" << dtype
+         << "));" << endl;
+  dec_indent();
+  stream << indent() << "}" << endl;
+  stream << "#endif" << endl;
+
   dec_indent();
   stream << indent() << "};" << endl;
   stream << indent() << tname << ' ' << t.name() << ";" << endl;
@@ -1563,6 +1649,8 @@ void Printer::Cpp::print_seq_init(const AST &ast) {
     stream << indent() << "checkpoint_interval = opts.checkpoint_interval;"
            << endl;
     stream << indent() << "keep_archives = opts.keep_archives;" << endl;
+    stream << indent() << "snapshot_archives = opts.snapshot_archives;"
+           << endl;
     stream << indent() << "std::string arg_string = "
            << "get_arg_str(opts.argc, opts.argv);" << endl;
     stream << indent() << "std::string formatted_interval = "
@@ -1581,7 +1669,14 @@ void Printer::Cpp::print_seq_init(const AST &ast) {
   for (std::vector<Statement::Var_Decl*>::const_iterator
        i = ast.seq_decls.begin(); i != ast.seq_decls.end();
        ++i, ++l, ++track) {
-    stream << indent() << *(*i)->name << ".copy("
+    stream << indent() << "if (opts.binary_input(" << track << "))\n";
+    stream << indent() << indent() << *(*i)->name << ".copy_binary("
+      << "inp[" << track << "].first"
+      << ", "
+      << "inp[" << track << "].second"
+      << ");\n";
+    stream << indent() << "else\n";
+    stream << indent() << indent() << *(*i)->name << ".copy("
       << "inp[" << track << "].first"
       << ", "
       << "inp[" << track << "].second"
@@ -1600,6 +1695,10 @@ void Printer::Cpp::print_seq_init(const AST &ast) {
         assert(false);
     }
   }
+  if (ast.compact_subseq) {
+    stream << indent() << "TUSubsequence::seq = &"
+      << *ast.seq_decls.front()->name << ";\n";
+  }
 
   // set the tile size to the specified tile size and
   // calculate max_tiles and max_tiles_n
@@ -1709,6 +1808,37 @@ void Printer::Cpp::print_filter_init(const AST &ast) {
 }
 
 
+// the band width, at most the longest input, such that all cells are
+// computed by default
+void Printer::Cpp::print_band_init(const AST &ast) {
+  if (!ast.banded) {
+    return;
+  }
+  stream << indent() << "band = std::min<size_t>(opts.band, "
+         << "std::max<size_t>({";
+  for (std::vector<Statement::Var_Decl*>::const_iterator j =
+       ast.seq_decls.begin(); j != ast.seq_decls.end(); ++j) {
+    if (j != ast.seq_decls.begin()) {
+      stream << ", ";
+    }
+    stream << *(*j)->name << ".size()";
+  }
+  stream << "}));" << endl;
+}
+
+
+// the tables attach to the row blocks in their init()
+void Printer::Cpp::print_row_blocks_init(const AST &ast) {
+  if (!ast.linear_space) {
+    return;
+  }
+  stream << indent() << "row_blocks.init(" << *ast.seq_decls.front()->name
+         << ".size() + 1, " << ast.row_depth << "," << endl;
+  stream << indent() << "    [this](size_t row_hi, size_t row_lo) "
+         << "{ cyk_rows(row_hi, row_lo); }, opts.row_block);" << endl;
+}
+
+
 void Printer::Cpp::print_table_init(const AST &ast) {
   for (hashtable<std::string, Symbol::NT*>::const_iterator i =
        ast.grammar()->tabulated.begin(); i != ast.grammar()->tabulated.end();
@@ -1726,13 +1856,20 @@ void Printer::Cpp::print_table_init(const AST &ast) {
     if (ast.window_mode) {
       stream << " opts.window_size, opts.window_increment, ";
     }
+    if (i->second->table_decl->band()) {
+      stream << "band, ";
+    }
+    if (i->second->table_decl->rows()) {
+      stream << "row_blocks, ";
+    }
 
     stream << "\""<< i->second->table_decl->name() << "\"";
     if (ast.checkpoint && !ast.checkpoint->is_buddy) {
       stream << ", opts.checkpoint_out_path," << endl;
       stream << indent() << "                opts.checkpoint_in_path, "
              << "arg_string, formatted_interval," << endl;
-      stream << indent() << "                file_prefix";
+      stream << indent() << "                file_prefix, "
+             << "opts.compress_threads";
     }
     stream << ");" << endl;
   }
@@ -1814,6 +1951,8 @@ void Printer::Cpp::print_init_fn(const AST &ast) {
   print_buddy_init(ast);
   print_seq_init(ast);
   print_filter_init(ast);
+  print_band_init(ast);
+  print_row_blocks_init(ast);
   print_table_init(ast);
 
   if (ast.checkpoint && !ast.checkpoint->is_buddy) {
@@ -1937,6 +2076,12 @@ void Printer::Cpp::header(const AST &ast) {
     if (ast.window_mode) {
       stream << "#define WINDOW_MODE\n";
     }
+    if (ast.banded) {
+      stream << "#define BANDED\n";
+    }
+    if (ast.linear_space) {
+      stream << "#define LINEAR_SPACE\n";
+    }
     if (ast.code_mode().sample()) {
       stream << "#define USE_GSL\n";
     }
@@ -1946,6 +2091,9 @@ void Printer::Cpp::header(const AST &ast) {
     if (ast.outside_generation()) {
       stream << "#define OUTSIDE\n";
     }
+    if (ast.compact_subseq) {
+      stream << "#define COMPACT_SUBSEQUENCE\n";
+    }
 
     stream << "#define GAPC_CALL_STRING \"" << gapc_call_string << "\""
            << endl;
@@ -1993,16 +2141,13 @@ void Printer::Cpp::header(const AST &ast) {
              << endl;
       stream << indent() << "boost::filesystem::path in_archive_path;"
              << endl;
-      stream << "#ifdef _OPENMP" << endl;
-      stream << indent() << "fair_shared_mutex mutex;" << endl;
-      stream << "#else" << endl;
-      stream << indent() << "fair_mutex mutex;" << endl;
-      stream << "#endif" << endl;
+      stream << indent() << "gapc::Checkpoint_Gate mutex;" << endl;
     }
     stream << indent() << "std::clock_t start_cpu_time;" << endl;
     stream << indent() << "std::string file_prefix;" << endl;
     stream << indent() << "std::atomic_bool cancel_token;" << endl;
     stream << indent() << "bool keep_archives;" << endl;
+    stream << indent() << "bool snapshot_archives;" << endl;
     stream << indent() << "bool load_checkpoint;" << endl;
     stream << indent() << "std::mutex print_mutex;" << endl;
     dec_indent();
@@ -2072,6 +2217,12 @@ void Printer::Cpp::header(const AST &ast) {
     stream << indent() << "unsigned wsize;" << endl;
     stream << indent() << "unsigned winc;" << endl;
   }
+  if (ast.banded) {
+    stream << indent() << "unsigned band;" << endl;
+  }
+  if (ast.linear_space) {
+    stream << indent() << "Table::Row_Blocks row_blocks;" << endl;
+  }
 
   stream << endl;
 
@@ -2147,6 +2298,27 @@ void Printer::Cpp::print_stats_fn(const AST &ast) {
 }
 
 
+void Printer::Cpp::print_table_profile_fn(const AST &ast) {
+  stream << indent() << "void print_table_profile(std::ostream &o) {" << endl;
+
+  stream << "#ifdef TABLE_PROFILE" << endl;
+
+  inc_indent();
+  stream << indent() << "o << \"n \" << t_0_seq.size() << '\\n';" << endl;
+  for (hashtable<std::string, Symbol::NT*>::const_iterator i =
+       ast.grammar()->tabulated.begin();
+       i != ast.grammar()->tabulated.end(); ++i) {
+    stream << indent() << i->second->table_decl->name()
+      << ".put_profile(o, \"" << i->first << "\");" << endl;
+  }
+  dec_indent();
+
+  stream << "#endif" << endl;
+
+  stream << indent() << '}' << endl << endl;
+}
+
+
 void Printer::Cpp::header_footer(const AST &ast) {
   dec_indent();
   stream << indent() << " private:" << endl;
@@ -2163,6 +2335,7 @@ void Printer::Cpp::header_footer(const AST &ast) {
       ast.checkpoint->parse_checkpoint_log(stream, true);
     }
     ast.checkpoint->archive_periodically(stream, tabulated);
+    ast.checkpoint->archive_snapshot(stream, tabulated);
     ast.checkpoint->remove_tables(stream, tabulated);
     ast.checkpoint->remove_log_file(stream);
     ast.checkpoint->format_interval(stream);
@@ -2183,6 +2356,7 @@ void Printer::Cpp::header_footer(const AST &ast) {
   inc_indent();
   print_run_fn(ast);
   print_stats_fn(ast);
+  print_table_profile_fn(ast);
 }
 
 
@@ -2208,6 +2382,9 @@ void Printer::Cpp::footer(const AST &ast) {
     inc_indent();
   }
   stream << *print_CYK(ast);
+  if (ast.linear_space) {
+    stream << *print_CYK_rows(ast);
+  }
 
   print_id();
 }
@@ -2304,8 +2481,12 @@ void Printer::Cpp::print_kbacktrack_pp(const AST &ast) {
     << "for (Backtrace_List<" << *bt_value
     << ", unsigned int>::iterator i = l->begin();"
     << endl
-    << "     i != l->end(); ++i)" << endl
+    << "     i != l->end(); ++i) {" << endl
     << "  (*i)->print(out);" << endl
+    // release the derivations of the printed class before the next
+    // class is backtraced
+    << "  erase(*i);" << endl
+    << "}" << endl
     << "}\n";
 }
 
@@ -2484,6 +2665,26 @@ void Printer::Cpp::backtrack_footer(const AST &ast) {
 
 
 void Printer::Cpp::print_value_pp(const AST &ast) {
+  if (ast.code_mode() != Code::Mode::BACKTRACK &&
+      ast.code_mode() != Code::Mode::SUBOPT) {
+    // numbers bypass the locale of the stream, see rtlib/output.hh;
+    // other values are printed in the scope of the generated class, which
+    // sees the operator<< of the user headers
+    stream << indent() << "template <typename Value>";
+    stream << " void print_value(std::ostream &out, Value &res, "
+           << "std::true_type) {" << endl;
+    inc_indent();
+    stream << indent() << "gapc::put(out, res);" << endl;
+    dec_indent();
+    stream << indent() << '}' << endl;
+    stream << indent() << "template <typename Value>";
+    stream << " void print_value(std::ostream &out, Value &res, "
+           << "std::false_type) {" << endl;
+    inc_indent();
+    stream << indent() << "out << res;" << endl;
+    dec_indent();
+    stream << indent() << '}' << endl << endl;
+  }
   stream << indent() << "template <typename Value>";
   stream << " void  print_result(std::ostream &out, "
          << "Value&" << " res) {" << endl;
@@ -2505,7 +2706,9 @@ void Printer::Cpp::print_value_pp(const AST &ast) {
   dec_indent();
   stream << indent() << "} else {" << endl;
   inc_indent();
-  stream << indent() << "out << res << '\\n';" << endl;
+  stream << indent() << "print_value(out, res, gapc::chars_number<Value>());"
+         << endl;
+  stream << indent() << "out << '\\n';" << endl;
   dec_indent();
   stream << indent() << '}' << endl;
 
@@ -2555,6 +2758,31 @@ void Printer::Cpp::prelude(const Options &opts, const AST &ast) {
 }
 
 
+/*
+   Head of the additional translation units of --split-code: they only
+   contain (member) function definitions of the class declared in the
+   header, thus globals which are defined once in the prelude and
+   global_constants are merely referenced here.
+*/
+void Printer::Cpp::split_prelude(const Options &opts, const AST &ast) {
+  stream << endl << make_comments(id_string, "//") << endl << endl;
+
+  // as in the main unit, this defines Singleton<T>::obj of
+  // rtlib/singleton.hh, which links, because a static data member of a
+  // class template may be defined in several units
+  stream << "#define GAPC_MOD_TRANSLATION_UNIT" << endl;
+
+  stream << "#include \"" << remove_dir(opts.header_file) << '"'
+    << endl << endl;
+
+  imports(ast);
+
+  if (ast.get_float_acc() != 0) {
+    stream << "#include \"rtlib/float_accuracy_operators.hh\"\n\n";
+  }
+}
+
+
 static const char deps[] =
 "basenameCXX=$(shell basename $(CXX))\n"
 "ifneq ($(filter $(basenameCXX),g++ icc),)\n"
@@ -2592,18 +2820,38 @@ void Printer::Cpp::makefile(const Options &opts) {
            << "$(info Including extra makefile $(MF))" << endl
            << "include $(MF)" << endl
        << "endif" << endl << endl;
+  // make GZIP_OUTPUT=1 enables the -z option, see rtlib/out_buffer.hh
+  stream << "ifdef GZIP_OUTPUT" << endl
+    << "CPPFLAGS += -DGZIP_OUTPUT" << endl
+    << "LDLIBS += -lz" << endl
+    << "endif" << endl << endl;
 
   std::string base = opts.class_name;  // basename(opts.out_file);
   std::string out_file = remove_dir(opts.out_file);
   std::string header_file = remove_dir(opts.header_file);
   stream << "CXXFILES =  " << base << "_main.cc "
-    << out_file << endl << endl;
+    << out_file;
+  for (std::vector<std::string>::const_iterator i = opts.split_files.begin();
+       i != opts.split_files.end(); ++i) {
+    stream << ' ' << remove_dir(*i);
+  }
+  stream << endl << endl;
   stream << "DEPS = $(CXXFILES:.cc=.d)" << endl
     << "OFILES = $(CXXFILES:.cc=.o) string.o" << endl << endl;
+
+  // all generated translation units start with the same define and
+  // include of the header, i.e. they can share one precompiled header
+  stream << "ifdef PCH" << endl
+    << "$(filter-out " << base << "_main.o string.o,$(OFILES)): "
+    << header_file << ".gch" << endl << endl
+    << header_file << ".gch: " << header_file << endl
+    << "\t$(CXX) $(CPPFLAGS) $(CXXFLAGS) -DGAPC_MOD_TRANSLATION_UNIT= "
+    << "-x c++-header $< -o $@" << endl
+    << "endif" << endl << endl;
   stream << opts.class_name << " : $(OFILES)" << endl
       << "\t$(CXX) -o $@ $^  $(LDFLAGS) $(LDLIBS)";
   if (opts.checkpointing) {
-    stream << " -lboost_serialization -lboost_filesystem -lpthread -ldl";
+    stream << " -lboost_serialization -lboost_filesystem -lpthread -ldl -lz";
   }
 
   // if (opts.sample) {
@@ -2621,8 +2869,8 @@ void Printer::Cpp::makefile(const Options &opts) {
     << endl;
   stream << deps << endl;
   stream << ".PHONY: clean" << endl << "clean:" << endl
-    << "\trm -f $(OFILES) " << opts.class_name << ' ' << base << "_main.cc"
-    << endl << endl;
+    << "\trm -f $(OFILES) " << opts.class_name << ' ' << base << "_main.cc "
+    << header_file << ".gch" << endl << endl;
 
   stream <<
     "string.o: $(RTLIB)/string.cc" << endl <<
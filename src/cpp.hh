@@ -68,6 +68,8 @@ class Cpp : public Base {
 
     void print_table_decls(const Grammar &grammar);
     void print_seq_init(const AST &ast);
+    void print_band_init(const AST &ast);
+    void print_row_blocks_init(const AST &ast);
     void print_table_init(const AST &ast);
     void print_zero_init(const Grammar &grammar);
     void print_most_decl(const Symbol::NT &nt);
@@ -79,6 +81,7 @@ class Cpp : public Base {
  private:
     void print_run_fn(const AST &ast);
     void print_stats_fn(const AST &ast);
+    void print_table_profile_fn(const AST &ast);
 
     void print_value_pp(const AST &ast);
 
@@ -96,18 +99,21 @@ class Cpp : public Base {
 
  public:
     bool in_class;
+    // only print function templates, i.e. choice functions, which have to
+    // be visible in every translation unit that calls them
+    bool templates_only;
     std::string class_name;
     Cpp()
       : Base(), ast(0), pure_list_type(false), in_fn_head(false),
       pointer_as_itr(false),
       choice_range(NULL),
-      in_class(false)
+      in_class(false), templates_only(false)
     {}
     Cpp(const AST &ast_, std::ostream &o)
       : Base(o), ast(&ast_), pure_list_type(false), in_fn_head(false),
       pointer_as_itr(false),
       choice_range(NULL),
-      in_class(false)
+      in_class(false), templates_only(false)
     {}
     void print(const Statement::For &stmt);
     void print(const Statement::While &stmt);
@@ -184,6 +190,7 @@ class Cpp : public Base {
     void typedefs(Code::Gen &code);
 
     void prelude(const Options &opts, const AST &ast);
+    void split_prelude(const Options &opts, const AST &ast);
     void imports(const AST &ast);
 
     void global_constants(const AST &ast);
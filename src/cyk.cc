@@ -921,15 +921,27 @@ std::list<Statement::Base*> *cyk_traversal_multithread_outside(const AST &ast,
 }
 
 
-size_t count_nt_calls_and_loops(Statement::For *loop) {
+static size_t count_nt_calls(const std::list<Statement::Base*> &stmts) {
   size_t res = 0;
-  for (std::list<Statement::Base*>::const_iterator i = loop->statements.begin();
-       i != loop->statements.end(); ++i) {
+  for (std::list<Statement::Base*>::const_iterator i = stmts.begin();
+       i != stmts.end(); ++i) {
     if ((*i)->is(Statement::FN_CALL) &&
         (dynamic_cast<Statement::Fn_Call*>(*i)->name().find(
             "nt_tabulate_", 0) == 0)) {
       res++;
     }
+    // guarded groups of nt calls, see fuse_nt_calls
+    if ((*i)->is(Statement::IF)) {
+      res += count_nt_calls(dynamic_cast<Statement::If*>(*i)->then);
+    }
+  }
+  return res;
+}
+
+size_t count_nt_calls_and_loops(Statement::For *loop) {
+  size_t res = count_nt_calls(loop->statements);
+  for (std::list<Statement::Base*>::const_iterator i = loop->statements.begin();
+       i != loop->statements.end(); ++i) {
     if ((*i)->is(Statement::FOR)) {
       res++;
     }
@@ -937,6 +949,75 @@ size_t count_nt_calls_and_loops(Statement::For *loop) {
   return res;
 }
 
+/* Fuses the NT calls of one cell: instead of each nt_tabulate_ function
+ * evaluating its yield size guard on entry (see Symbol::NT::codegen), the
+ * guards are hoisted into the cell body and consecutive NT calls with the
+ * same guard share one check. NTs whose guard fails for the cell are not
+ * called at all. The order of the calls, i.e. the dependencies among NTs
+ * of the same cell, is kept.
+ */
+static void fuse_nt_calls(
+    std::list<Statement::Base*> &stmts,
+    const std::list<std::pair<Expr::Base*, Statement::Fn_Call*> > &calls) {
+  Statement::If *group = NULL;
+  std::string group_guard;
+  for (std::list<std::pair<Expr::Base*, Statement::Fn_Call*> >::const_iterator
+       i = calls.begin(); i != calls.end(); ++i) {
+    if (!i->first) {
+      group = NULL;
+      stmts.push_back(i->second);
+      continue;
+    }
+    std::ostringstream o;
+    o << *i->first;
+    if (!group || o.str() != group_guard) {
+      group = new Statement::If(new Expr::Not(i->first));
+      group_guard = o.str();
+      stmts.push_back(group);
+    }
+    group->then.push_back(i->second);
+  }
+}
+
+/* The yield size guard of an nt_tabulate_ call with the index arguments
+ * args, or NULL if the NT has no yield size restrictions. The arguments are
+ * converted to the unsigned parameter type of nt_tabulate_, such that the
+ * guard computes exactly what the function would have checked. In band
+ * mode, the guard also skips the cells outside of the band.
+ */
+static Expr::Base *nt_call_guard(const Symbol::NT &nt,
+                                 const std::list<Expr::Base*> &args,
+                                 bool band) {
+  std::vector<Expr::Base*> left, right;
+  std::list<Expr::Base*>::const_iterator a = args.begin();
+  for (size_t t = 0; t < nt.tracks(); ++t) {
+    for (int side = 0; side < 2; ++side) {
+      bool deleted = side == 0 ? nt.tables()[t].delete_left_index()
+                               : nt.tables()[t].delete_right_index();
+      Expr::Base *idx = side == 0 ? nt.left_indices.at(t)
+                                  : nt.right_indices.at(t);
+      if (!deleted) {
+        assert(a != args.end());
+        Expr::Fn_Call *cast = new Expr::Fn_Call(
+            new std::string("static_cast<unsigned int>"));
+        cast->add_arg(*a++);
+        idx = cast;
+      }
+      (side == 0 ? left : right).push_back(idx);
+    }
+  }
+  std::list<Expr::Base*> ors;
+  nt.gen_ys_guards(ors, left, right);
+  if (band && nt.tracks() > 1) {
+    nt.gen_band_guards(ors, left, right,
+                       new Expr::Vacc(new std::string("band")));
+  }
+  if (ors.empty()) {
+    return NULL;
+  }
+  return Expr::seq_to_tree<Expr::Base, Expr::Or>(ors.begin(), ors.end());
+}
+
 /* This function will add NT calls (and mutex operations) into a given CYK
  * traversal structure in a recursive fashion. The challenge is to add an NT
  * call into the correct level of nested for loops, i.e. only as deep as the NT
@@ -1011,13 +1092,14 @@ std::list<Statement::Base*> *add_nt_calls(std::list<Statement::Base*> &stmts,
 
   // add NTs
   std::list<Statement::Base*> *nt_stmts = new std::list<Statement::Base*>();
+  std::list<std::pair<Expr::Base*, Statement::Fn_Call*> > nt_calls;
   if (with_checkpoint) {
     if ((mode == CYKmode::SINGLETHREAD) ||
         (mode == CYKmode::SINGLETHREAD_OUTSIDE)) {
       // don't add mutex on top level, as it's context would never end
       if (loop_vars->size() > 0) {
         nt_stmts->push_back(new Statement::CustomCode(
-          "std::lock_guard<fair_mutex> lock(mutex);"));
+          "std::shared_lock<gapc::Checkpoint_Gate> lock(mutex);"));
       }
     } else {
       if (mode == CYKmode::OPENMP_SERIAL) {
@@ -1128,9 +1210,11 @@ std::list<Statement::Base*> *add_nt_calls(std::list<Statement::Base*> &stmts,
         assert((*i)->code_list().size() > 0);
         Statement::Fn_Call *nt_call = new Statement::Fn_Call(
             (*(*i)->code_list().rbegin())->name, args, Loc());
-        nt_stmts->push_back(nt_call);
+        nt_calls.push_back(std::make_pair(
+            nt_call_guard(**i, *args, ast.banded), nt_call));
     }
   }
+  fuse_nt_calls(*nt_stmts, nt_calls);
   if (with_checkpoint) {
     if ((mode == CYKmode::OPENMP_SERIAL) ||
         (mode == CYKmode::OPENMP_SERIAL_OUTSIDE)) {
@@ -1141,6 +1225,129 @@ std::list<Statement::Base*> *add_nt_calls(std::list<Statement::Base*> &stmts,
   return nt_stmts;
 }
 
+/* Restricts the loops of the other tracks to the band (gapc --band), if
+ * they are nested in the loop of the same index of track 0, e.g.
+ *   for (t_1_i = min(t_1_j + 1, t_0_i + band);
+ *        t_1_i > max(1, t_0_i - band - 1); ...
+ * All NT calls in such a loop use both indices, i.e. they are banded, thus
+ * no computed cell is skipped. The loops of the border cells are not
+ * restricted, their NT calls are skipped by the band guards.
+ */
+static void restrict_to_band(std::list<Statement::Base*> &stmts,
+                             std::list<std::string> &outer) {
+  Expr::Base *band = new Expr::Vacc(new std::string("band"));
+  for (std::list<Statement::Base*>::iterator s = stmts.begin();
+       s != stmts.end(); ++s) {
+    if (!(*s)->is(Statement::FOR)) {
+      continue;
+    }
+    Statement::For *fl = dynamic_cast<Statement::For*>(*s);
+    const std::string &name = *fl->var_decl->name;
+    std::string first;
+    if (name.find("t_") == 0) {
+      first = "t_0" + name.substr(name.rfind('_'));
+    }
+    if (!first.empty() && name != first &&
+        std::find(outer.begin(), outer.end(), first) != outer.end()) {
+      Expr::Base *x0 = new Expr::Vacc(new std::string(first));
+      Expr::Vacc *x = new Expr::Vacc(fl->var_decl->name);
+      // the var decl is shared with the copies of the loop for the
+      // other regions of track 0
+      Statement::Var_Decl *v = fl->var_decl->clone();
+      Expr::Base *start = v->rhs;
+      Expr::Base *end = dynamic_cast<Expr::Two*>(fl->cond)->right();
+      if (name[name.size() - 1] == 'i') {
+        // arguments t_x_i - 1, descending
+        Expr::Base *hi = x0->plus(band);
+        v->rhs = new Expr::Cond(new Expr::Less(start, hi), start, hi);
+        fl->cond = new Expr::Greater(x, new Expr::Cond(
+          new Expr::Greater(x0, end->plus(band)->plus(new Expr::Const(1))),
+          x0->minus(band)->minus(new Expr::Const(1)), end));
+      } else {
+        // arguments t_x_j, ascending
+        Expr::Base *hi = x0->plus(band)->plus(new Expr::Const(1));
+        v->rhs = new Expr::Cond(new Expr::Greater(x0, start->plus(band)),
+                                x0->minus(band), start);
+        fl->cond = new Expr::Less(x, new Expr::Cond(
+          new Expr::Less(hi, end), hi, end));
+      }
+      fl->var_decl = v;
+    }
+    outer.push_back(name);
+    restrict_to_band(fl->statements, outer);
+    outer.pop_back();
+  }
+}
+
+/* Restricts the traversal to the rows row_hi down to row_lo of the tables
+ * (gapc --linear-space), i.e. to the arguments t_0_i - 1 of the loop of the
+ * last column of track 0, whose first row is computed after the loop:
+ *   for (t_0_i = min(t_0_j + 1, row_hi + 1); t_0_i > max(1, row_lo); ...
+ *   t_0_i = 1;
+ *   if (row_lo == 0) { ... }
+ * The tables of all NTs are linear in track 0, thus the other loops of
+ * track 0 contain no NT calls.
+ */
+static void restrict_to_rows(std::list<Statement::Base*> &stmts,
+                             const std::string &row) {
+  Expr::Base *hi = new Expr::Vacc(new std::string("row_hi"));
+  Expr::Base *lo = new Expr::Vacc(new std::string("row_lo"));
+  std::list<Statement::Base*>::iterator s = stmts.begin();
+  for (; s != stmts.end(); ++s) {
+    if ((*s)->is(Statement::VAR_DECL) &&
+        *dynamic_cast<Statement::Var_Decl*>(*s)->name == row) {
+      ++s;
+      break;
+    }
+    if (!(*s)->is(Statement::FOR)) {
+      continue;
+    }
+    Statement::For *fl = dynamic_cast<Statement::For*>(*s);
+    if (*fl->var_decl->name != row) {
+      continue;
+    }
+    Statement::Var_Decl *v = fl->var_decl->clone();
+    Expr::Base *start = v->rhs;
+    Expr::Base *first = hi->plus(new Expr::Const(1));
+    v->rhs = new Expr::Cond(new Expr::Less(start, first), start, first);
+    Expr::Base *end = dynamic_cast<Expr::Two*>(fl->cond)->right();
+    fl->cond = new Expr::Greater(new Expr::Vacc(v->name),
+      new Expr::Cond(new Expr::Greater(lo, end), lo, end));
+    fl->var_decl = v;
+  }
+  Statement::If *top = new Statement::If(
+    new Expr::Eq(lo, new Expr::Const(0)));
+  top->then.insert(top->then.end(), s, stmts.end());
+  stmts.erase(s, stmts.end());
+  stmts.push_back(top);
+}
+
+/* gapc --linear-space: the single thread cyk loops for the rows row_hi
+ * down to row_lo of the tables. cyk() computes all rows, the backtrace
+ * recomputes the evicted blocks of rows, see rtlib/row_table.hh
+ */
+Fn_Def *print_CYK_rows(const AST &ast) {
+  Fn_Def *fn = new Fn_Def(new Type::RealVoid(),
+                          new std::string("cyk_rows"));
+  fn->add_para(new Type::Size(), new std::string("row_hi"));
+  fn->add_para(new Type::Size(), new std::string("row_lo"));
+
+  std::list<Statement::Base*> *stmts = cyk_traversal_singlethread(
+      ast, CYKmode::SINGLETHREAD);
+  std::list<Statement::Base*> *new_stmts = add_nt_calls(*stmts,
+      new std::list<std::string*>(), ast.grammar()->topological_ord(),
+      false, CYKmode::SINGLETHREAD, ast);
+  stmts->insert(stmts->end(), new_stmts->begin(), new_stmts->end());
+  if (ast.banded) {
+    std::list<std::string> outer;
+    restrict_to_band(*stmts, outer);
+  }
+  restrict_to_rows(*stmts,
+                   *ast.grammar()->left_running_indices.at(0)->name());
+  fn->stmts.insert(fn->stmts.end(), stmts->begin(), stmts->end());
+  return fn;
+}
+
 Fn_Def *print_CYK(const AST &ast) {
   Fn_Def *fn_cyk = new Fn_Def(new Type::RealVoid(), new std::string("cyk"));
   if (!ast.cyk()) {
@@ -1151,6 +1358,12 @@ Fn_Def *print_CYK(const AST &ast) {
     return fn_cyk;
   }
 
+  if (ast.linear_space) {
+    fn_cyk->stmts.push_back(new Statement::CustomCode(
+      "cyk_rows(" + *ast.seq_decls.front()->name + ".size(), 0);"));
+    return fn_cyk;
+  }
+
   if (ast.checkpoint && ast.checkpoint->cyk) {
   /*
     define a boolean marker (as an int) for every loop idx
@@ -1225,6 +1438,10 @@ Fn_Def *print_CYK(const AST &ast) {
       new std::list<std::string*>(), ast.grammar()->topological_ord(),
       ast.checkpoint && ast.checkpoint->cyk, CYKmode::SINGLETHREAD, ast);
   stmts->insert(stmts->end(), new_stmts->begin(), new_stmts->end());
+  if (ast.banded) {
+    std::list<std::string> outer;
+    restrict_to_band(*stmts, outer);
+  }
   // finally add traversal structure with NT calls to function body
   if (ast.outside_generation()) {
     fn_cyk->stmts.push_back(new Statement::CustomCode(
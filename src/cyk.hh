@@ -24,10 +24,13 @@
 #ifndef SRC_CYK_HH_
 #define SRC_CYK_HH_
 
+#include <algorithm>
 #include <list>
 #include <vector>
 #include <string>
 #include <tuple>
+#include <sstream>
+#include <utility>
 
 #include "ast.hh"
 #include "printer.hh"
@@ -49,5 +52,6 @@ Statement::Var_Decl*
 get_tile_computation_outside(Statement::Var_Decl *input_seq);
 
 Fn_Def *print_CYK(const AST &ast);
+Fn_Def *print_CYK_rows(const AST &ast);
 
 #endif /* SRC_CYK_HH_ */
@@ -42,6 +42,8 @@
 #include "version.hh"
 
 #include "options.hh"
+#include "table_profile.hh"
+#include "pass_report.hh"
 #include "backtrack.hh"
 #include "subopt.hh"
 #include "kbacktrack.hh"
@@ -88,7 +90,37 @@ static void parse_options(int argc, char **argv, Options *rec) {
       "automatically compute optimal table configuration (ignore conf from "
       "source file)")
     ("tab-all", "tabulate everything")
+    ("sparse-tab", po::value< std::vector<std::string> >(),
+      "store the tables of these non-terminals in a hash table, for tables "
+      "of which only few cells are computed (not with --cyk)")
+    ("soa-tables",
+      "store the tables of pair typed non-terminals as structure of arrays, "
+      "i.e. the components of all cells in separate arrays")
+    ("fixed-size", po::value<size_t>(),
+      "store the tables in arrays inside of the generated class, sized for "
+      "inputs of up to this length, such that short inputs need no heap "
+      "allocated tables; longer inputs use heap allocated tables")
+    ("band",
+      "banded DP for multi-track programs, e.g. pairwise alignments: only "
+      "table cells whose indices differ by at most the band width (runtime "
+      "option -a) between track 0 and the other tracks are computed and "
+      "stored")
+    ("linear-space",
+      "with --cyk or --auto-cyk, for multi-track programs whose tables are "
+      "linear in track 0, e.g. pairwise alignments: only a few rows of the "
+      "tables are kept in memory, the backtrace recomputes the others")
+    ("table-profile", po::value<std::string>(),
+      "compute the table configuration from the measured table usage of a "
+      "binary compiled with --tab-all and -DTABLE_PROFILE (ignore conf from "
+      "source file)")
+    ("table-memory", po::value<uint64_t>(),
+      "with --table-profile, the memory budget in MB for all tables at the "
+      "profiled input length (default: unlimited)")
     ("cyk", "bottom up evalulation codgen (default: top down unger style)")
+    ("auto-cyk",
+      "use the bottom up evaluation of --cyk, if a tabulated non-terminal "
+      "calls itself, i.e. if the depth of the top down recursion grows "
+      "with the input length and long inputs would overflow the stack")
     ("backtrace", "use backtracing for the pretty print RHS of the product")
     ("kbacktrace", "backtracing for k-scoring lhs")
     ("subopt-classify", "classified dp")
@@ -97,6 +129,9 @@ static void parse_options(int argc, char **argv, Options *rec) {
     ("no-coopt", "with kbacktrace, don't output cooptimal candidates")
     ("no-coopt-class", "with kbacktrace, don't output cooptimal candidates")
     ("window-mode,w", "window mode")
+    ("no-compact-subseq",
+      "store the sequence pointer in every Subsequence object (default for "
+      "one track programs: Subsequence only stores its indices)")
     ("kbest", "classify the k-best classes only")
     ("ambiguity",
       "converts the selected instance into a context free string grammar")
@@ -150,7 +185,16 @@ static void parse_options(int argc, char **argv, Options *rec) {
      "Checkpointing interval can be configured in the generated binary\n"
      "(creates new checkpoint every "
      + std::to_string(DEFAULT_CP_INTERVAL_MIN)
-     + " minutes by default)\n").c_str());
+     + " minutes by default)\n").c_str())
+    ("split-code", po::value<unsigned int>(),
+      "distribute the non-terminal functions over this number of additional "
+      "translation units (out_1.cc, out_2.cc, ...), such that large "
+      "grammars can be compiled in parallel with make -j. The generated "
+      "makefile also supports a precompiled header via make PCH=1.")
+    ("time-passes", "print the wall and cpu time of each compiler pass to "
+      "stderr")
+    ("memory-passes", "print the resident set size after each compiler "
+      "pass and its change during the pass to stderr");
 
   po::options_description hidden("");
   hidden.add_options()
@@ -212,12 +256,28 @@ static void parse_options(int argc, char **argv, Options *rec) {
     rec->approx_table_design = true;
   if (vm.count("tab-all"))
     rec->tab_everything = true;
+  if (vm.count("table-profile"))
+    rec->table_profile = vm["table-profile"].as<std::string>();
+  if (vm.count("table-memory"))
+    rec->table_memory = vm["table-memory"].as<uint64_t>();
   if (vm.count("tab"))
     rec->tab_list = vm["tab"].as< std::vector<std::string> >();
+  if (vm.count("sparse-tab"))
+    rec->sparse_tab_list = vm["sparse-tab"].as< std::vector<std::string> >();
+  if (vm.count("soa-tables"))
+    rec->soa_tables = true;
+  if (vm.count("fixed-size"))
+    rec->fixed_size = vm["fixed-size"].as<size_t>();
+  if (vm.count("band"))
+    rec->band = true;
+  if (vm.count("linear-space"))
+    rec->linear_space = true;
   if (vm.count("include"))
     rec->includes = vm["include"].as< std::vector<std::string> >();
   if (vm.count("cyk"))
     rec->cyk = true;
+  if (vm.count("auto-cyk"))
+    rec->auto_cyk = true;
   if (vm.count("backtrack") || vm.count("backtrace") || vm.count("sample"))
     rec->backtrack = true;
   if (vm.count("sample"))
@@ -232,6 +292,8 @@ static void parse_options(int argc, char **argv, Options *rec) {
     rec->no_coopt_class = true;
   if (vm.count("subopt-classify"))
     rec->classified = true;
+  if (vm.count("no-compact-subseq"))
+    rec->no_compact_subseq = true;
   if (vm.count("window-mode"))
     rec->window_mode = true;
   if (vm.count("kbest"))
@@ -289,6 +351,21 @@ static void parse_options(int argc, char **argv, Options *rec) {
     rec->checkpointing = true;
   }
 
+  if (vm.count("split-code")) {
+    rec->split_code = vm["split-code"].as<unsigned int>();
+    for (unsigned int k = 1; k <= rec->split_code; ++k) {
+      rec->split_files.push_back(
+        basename(rec->out_file) + "_" + std::to_string(k) + ".cc");
+    }
+  }
+
+  if (vm.count("time-passes")) {
+    rec->time_passes = true;
+  }
+  if (vm.count("memory-passes")) {
+    rec->memory_passes = true;
+  }
+
   bool r = rec->check();
   if (!r) {
     throw LogError("Seen improper option usage.");
@@ -316,6 +393,9 @@ class Main {
 
   Code::Gen code_;
 
+  // --time-passes and --memory-passes statistics
+  Pass_Report passes;
+
   // classified product are replaced by times product
   void conv_classified_product(Options *opts) {
     Instance *instance = driver.ast.instance(opts->instance);
@@ -355,11 +435,15 @@ class Main {
       Log::instance()->setLogLevel(Log::LogLevel(opts.logLevel));
     }
 
+    passes.enable(opts.time_passes, opts.memory_passes);
+    Pass_Report::Scope front_pass(passes, "front");
+
     // set the file name of the gap-source-code
     driver.setFilename(opts.in_file);
     driver.set_includes(opts.includes);
 
     // parses the input file and builds the AST
+    passes.begin("parse");
     driver.parse();
     // Sets the active "instance" used for translation. For
     // more information on this see the comment of the method
@@ -371,6 +455,7 @@ class Main {
     if (driver.is_failing()) {
       throw LogError("Seen parse errors.");
     }
+    passes.end();
 
     // simply gets the selected grammar, which is either the
     // grammar that occured first in the source code or is the
@@ -381,18 +466,25 @@ class Main {
     // that links the grammar graph together, and computes yield-sizes.
     // If the method returns false, there are some semantic errors,
     // which leads to the end of the compilation process.
+    passes.begin("check_semantic");
     bool r = grammar->check_semantic();
     if (!r) {
       throw LogError("Seen semantic errors.");
     }
+    passes.end();
 
     // transform inside grammar into an outside one, if user requests
     if (driver.ast.outside_generation()) {
+      Pass_Report::Scope p(passes, "convert_to_outside");
       grammar->convert_to_outside();
     }
 
     // configure the window and k-best mode
     driver.ast.set_window_mode(opts.window_mode);
+    driver.ast.set_banded(opts.band);
+    // the buddy class of classified products has its own input sequence
+    driver.ast.set_compact_subseq(!opts.no_compact_subseq &&
+                                  !opts.classified);
     driver.ast.kbest = Bool(opts.kbest);
 
     if (opts.cyk) {
@@ -401,6 +493,7 @@ class Main {
 
     // Generate a table design, depending on the options set
     // by the user.
+    passes.begin("table_design");
     if (opts.tab_everything) {
       grammar->set_all_tabulated();
     }
@@ -411,6 +504,22 @@ class Main {
     if (opts.approx_table_design) {
       grammar->approx_table_conf();
     }
+    if (!opts.table_profile.empty()) {
+      Table_Profile profile;
+      profile.read(opts.table_profile);
+      grammar->profile_table_conf(profile, opts.table_memory << 20);
+    }
+    if (!opts.sparse_tab_list.empty()) {
+      grammar->set_sparse_tables(opts.sparse_tab_list);
+    }
+    if (opts.soa_tables) {
+      grammar->set_soa_tables();
+    }
+    if (opts.fixed_size) {
+      grammar->set_fixed_tables(opts.fixed_size);
+    }
+    driver.ast.set_linear_space(opts.linear_space);
+    passes.end();
     // TODO(sjanssen): better write message to Log instance, instead of
     // std::cout directly!
     if (Log::instance()->is_verbose()) {
@@ -426,8 +535,25 @@ class Main {
     // suboptimal designs and present a message to the user.
     driver.ast.warn_user_table_conf_suboptimal();
 
+    // the nested nt calls of the top-down evaluation would need a stack
+    // that grows with the input length; decided after the automatic table
+    // design of the warning above
+    if (opts.auto_cyk && !opts.cyk &&
+        (opts.linear_space || grammar->deep_recursion())) {
+      Log::instance()->verboseMessage(opts.linear_space ?
+        "--linear-space needs the bottom up evaluation, using --cyk." :
+        "Tabulated non-terminals are recursive, using --cyk.");
+      opts.cyk = true;
+      driver.ast.set_cyk();
+      if (!opts.sparse_tab_list.empty()) {
+        Log::instance()->warning(
+          "--sparse-tab is ignored in the bottom up evaluation.");
+      }
+    }
+
     // find what type of input is read
     // chars, sequence of ints etc.
+    passes.begin("check_algebras");
     driver.ast.derive_temp_alphabet();
 
     r = driver.ast.check_signature();
@@ -440,6 +566,7 @@ class Main {
     }
     // apply this to identify standard functions like Min, Max, Exp etc.
     driver.ast.derive_roles();
+    passes.end();
   }
 
 
@@ -449,6 +576,8 @@ class Main {
    * of the product, then for both algebras of the product.
    */
   void back(Instance *i = 0, Instance *instance_buddy = 0) {
+    Pass_Report::Scope back_pass(passes,
+                                 opts.classified ? "back (buddy)" : "back");
     Instance *instance = i;
     if (!i || instance_buddy) {
       if (opts.backtrack || opts.subopt || opts.kbacktrack) {
@@ -574,10 +703,12 @@ class Main {
       driver.ast.instance_->product->set_no_coopt_class();
     }
 
+    passes.begin("insert_instance");
     bool r = driver.ast.insert_instance(instance);
     if (!r) {
       throw LogError("Instance inserting errors.");
     }
+    passes.end();
 
     // no many results for single backtrace
     // or overlay does not define backtrace
@@ -585,7 +716,9 @@ class Main {
 
     // remove lists in the definitions where-ever possible
     // for example for Min or max choice functions
+    passes.begin("instance_grammar_eliminate_lists");
     driver.ast.instance_grammar_eliminate_lists(instance);
+    passes.end();
 
     if (opts.checkpointing) {
       if (driver.ast.checkpoint) {
@@ -601,6 +734,7 @@ class Main {
 
       Printer::Checkpoint *cp = new Printer::Checkpoint();
       driver.ast.checkpoint = cp;
+      cp->compact_subseq = driver.ast.compact_subseq;
 
       if (opts.classified) {
         /*
@@ -635,6 +769,7 @@ class Main {
       }
     }
 
+    passes.begin("init_grammar");
     Grammar *grammar = driver.ast.grammar();
     grammar->init_list_sizes();
     driver.ast.warn_missing_choice_fns(instance);
@@ -649,17 +784,26 @@ class Main {
     grammar->init_decls();
     // for cyk (ordering of NT for parsing, see page 101 of the thesis)
     grammar->dep_analysis();
+    passes.end();
 
     driver.ast.set_adp_version(*instance, opts.specialization,
                                opts.step_option, opts.pareto);
 
+    passes.begin("codegen");
     driver.ast.codegen();
+    passes.end();
 
+    passes.begin("instance_codegen");
     instance->codegen();
+    passes.end();
 
     if (opts.specialization == 0) {
+        passes.begin("optimize_choice");
         driver.ast.optimize_choice(*instance);
+        passes.end();
+        passes.begin("optimize_classify");
         driver.ast.optimize_classify(*instance);
+        passes.end();
     } else {
         Log::instance()->warning(
           "Choice function and classification optimization are disabled for "
@@ -689,6 +833,7 @@ class Main {
     // as a destination for the next lines. This is not the only
     // place where the stream is written. The method Main.finish()
     // also writes some lines to the header file.
+    passes.begin("print_header");
     Printer::Cpp hh(driver.ast, opts.h_stream());
     hh.set_argv(argv, argc);
     hh.class_name = opts.class_name;
@@ -702,9 +847,11 @@ class Main {
     if (driver.ast.outside_generation()) {
       print_insideoutside_report_fn(hh, driver.ast);
     }
+    passes.end();
 
     // Write out the C++ implementation file of the
     // compile-result.
+    passes.begin("print_code");
     Printer::Cpp cc(driver.ast, opts.stream());
     cc.set_argv(argv, argc);
     cc.class_name = opts.class_name;
@@ -712,10 +859,27 @@ class Main {
     cc.prelude(opts, driver.ast);
     cc.imports(driver.ast);
     cc.global_constants(driver.ast);
-    driver.ast.print_code(cc);
+    size_t parts = opts.split_code + 1;
+    driver.ast.print_code(cc, 0, parts);
     instance->print_code(cc);
     cc.footer(driver.ast);
 
+    // the remaining non-terminal functions go into separate translation
+    // units; they are members of the class declared in the header, i.e.
+    // only the choice function templates have to be repeated there
+    for (size_t k = 1; k < parts; ++k) {
+      Printer::Cpp sc(driver.ast, opts.split_stream(k - 1));
+      sc.set_argv(argv, argc);
+      sc.class_name = opts.class_name;
+      sc.set_files(opts.in_file, opts.split_files[k - 1]);
+      sc.split_prelude(opts, driver.ast);
+      sc.templates_only = true;
+      instance->print_code(sc);
+      sc.templates_only = false;
+      driver.ast.print_code(sc, k, parts);
+    }
+    passes.end();
+
     Code::Gen code(driver.ast);
     code_ = code;
 
@@ -735,9 +899,13 @@ class Main {
            driver.ast.code_mode().set_keep_cooptimal(!opts.no_coopt_class);
       }
 
+      passes.begin("backtrack_gen");
       driver.ast.backtrack_gen(*bt);
+      passes.end();
+      passes.begin("print_backtrack");
       bt->print_header(hh, driver.ast);
       bt->print_body(cc, driver.ast);
+      passes.end();
     }
 
     hh.backtrack_footer(driver.ast);
@@ -752,6 +920,7 @@ class Main {
    * taken place.
    */
   void finish() {
+    Pass_Report::Scope p(passes, "finish");
     Printer::Cpp hh(driver.ast, opts.h_stream());
     hh.class_name = opts.class_name;
     hh.typedefs(code_);
@@ -764,6 +933,7 @@ class Main {
    * Precondition: the AST must have been created and configured.
    */
   void makefile() {
+    Pass_Report::Scope p(passes, "makefile");
     Printer::Cpp mm(driver.ast, opts.m_stream());
     mm.set_argv(argv, argc);
     mm.makefile(opts);
@@ -783,10 +953,18 @@ class Main {
    * This is the entry point where the software starts.
    */
   void runKernal() {
-    makefile();
-
     conv_classified_product(&opts);
 
+    if (opts.classified && opts.split_code > 0) {
+      Log::instance()->warning(
+        "--split-code is not supported for classified products, all code "
+        "is written to " + opts.out_file + ".");
+      opts.split_code = 0;
+      opts.split_files.clear();
+    }
+
+    makefile();
+
     if (opts.classified) {
       std::string class_name = opts.class_name;
       bool kbacktrack = opts.kbacktrack;
@@ -912,12 +1090,18 @@ class Main {
     // If we simply want to check the ambiguity of an instance,
     // we do nothing else.
     if (opts.ambiguityCheck) {
+      Pass_Report::Scope p(passes, "ambiguity_cfg");
       runAmbuigutyCFGGenerator();
     } else if (opts.specializeGrammar) {
+      Pass_Report::Scope p(passes, "specialize_grammar");
       runSpecializingGrammarGenerator();
     } else {
       runKernal();
     }
+
+    if (passes.enabled()) {
+      passes.print(std::cerr);
+    }
   }
 };
 
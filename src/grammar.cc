@@ -24,6 +24,10 @@
 
 #include <iostream>
 #include <algorithm>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <vector>
 
 #include "alt.hh"
 
@@ -50,6 +54,7 @@
 #include "dep_analysis.hh"
 
 #include "symbol.hh"
+#include "table_profile.hh"
 
 
 void Grammar::add_nt(Symbol::NT *nt) {
@@ -400,6 +405,189 @@ void Grammar::window_table_dims() {
 }
 
 
+#include "fn_arg.hh"
+
+// row distances (gapc --linear-space), i.e. differences of the left
+// indices of track 0; NO_ROW: no tabulated NT is used
+static const int NO_ROW = -1;
+static const int ROWS_UNBOUNDED = std::numeric_limits<int>::max();
+
+static int row_distance(Symbol::NT *nt, size_t track,
+                        std::set<Symbol::NT*> &visiting);
+
+// maximal distance of the rows of the tabulated NTs that are used by a
+// to the left index of a, in track track of a
+static int row_distance(Alt::Base *a, size_t track,
+                        std::set<Symbol::NT*> &visiting) {
+  if (a->is(Alt::SIMPLE)) {
+    Alt::Simple *s = dynamic_cast<Alt::Simple*>(a);
+    int r = NO_ROW;
+    Yield::Poly left(0);
+    for (std::list<Fn_Arg::Base*>::iterator i = s->args.begin();
+         i != s->args.end(); ++i) {
+      if ((*i)->is(Fn_Arg::ALT)) {
+        int d = row_distance((*i)->alt_ref(), track, visiting);
+        if (d == ROWS_UNBOUNDED || (d != NO_ROW && left == Yield::UP)) {
+          return ROWS_UNBOUNDED;
+        }
+        if (d != NO_ROW) {
+          r = std::max<int>(r, d + left.konst());
+        }
+      }
+      left += (*i)->multi_ys()(track).high();
+    }
+    return r;
+  }
+  if (a->is(Alt::LINK)) {
+    Alt::Link *l = dynamic_cast<Alt::Link*>(a);
+    if (!l->nt->is(Symbol::NONTERMINAL)) {
+      return NO_ROW;
+    }
+    // explicit indices might address any row
+    if (l->is_explicit()) {
+      return ROWS_UNBOUNDED;
+    }
+    return row_distance(dynamic_cast<Symbol::NT*>(l->nt), track, visiting);
+  }
+  if (a->is(Alt::BLOCK)) {
+    Alt::Block *b = dynamic_cast<Alt::Block*>(a);
+    int r = NO_ROW;
+    for (std::list<Alt::Base*>::iterator i = b->alts.begin();
+         i != b->alts.end(); ++i) {
+      r = std::max(r, row_distance(*i, track, visiting));
+    }
+    return r;
+  }
+  if (a->is(Alt::MULTI)) {
+    // the components are single-track alternatives
+    Alt::Multi *m = dynamic_cast<Alt::Multi*>(a);
+    size_t k = 0;
+    for (std::list<Alt::Base*>::const_iterator i =
+         m->components().begin(); i != m->components().end(); ++i, ++k) {
+      if (k == track) {
+        return row_distance(*i, 0, visiting);
+      }
+    }
+    return NO_ROW;
+  }
+  return ROWS_UNBOUNDED;
+}
+
+static int row_distance(Symbol::NT *nt, size_t track,
+                        std::set<Symbol::NT*> &visiting) {
+  if (nt->is_tabulated()) {
+    return 0;
+  }
+  if (visiting.find(nt) != visiting.end()) {
+    return ROWS_UNBOUNDED;
+  }
+  visiting.insert(nt);
+  int r = NO_ROW;
+  for (std::list<Alt::Base*>::iterator i = nt->alts.begin();
+       i != nt->alts.end(); ++i) {
+    r = std::max(r, row_distance(*i, track, visiting));
+  }
+  visiting.erase(nt);
+  return r;
+}
+
+bool Grammar::row_distance(size_t &d) const {
+  d = 0;
+  for (hashtable<std::string, Symbol::NT*>::const_iterator i =
+       tabulated.begin(); i != tabulated.end(); ++i) {
+    Symbol::NT *nt = i->second;
+    if (nt->track_pos() != 0 || nt->tracks() != axiom->tracks()) {
+      return false;
+    }
+    const Table &table = nt->tables()[0];
+    if (table.type() != Table::LINEAR || table.delete_left_index() ||
+        !table.delete_right_index()) {
+      return false;
+    }
+    std::set<Symbol::NT*> visiting;
+    for (std::list<Alt::Base*>::iterator j = nt->alts.begin();
+         j != nt->alts.end(); ++j) {
+      int r = ::row_distance(*j, 0, visiting);
+      if (r == ROWS_UNBOUNDED) {
+        return false;
+      }
+      d = std::max<size_t>(d, std::max(r, 0));
+    }
+  }
+  return true;
+}
+
+
+// the NTs that a calls directly, i.e. not via other NTs
+static void collect_calls(Alt::Base *a, std::set<Symbol::NT*> &calls) {
+  if (a->is(Alt::SIMPLE)) {
+    Alt::Simple *s = dynamic_cast<Alt::Simple*>(a);
+    for (std::list<Fn_Arg::Base*>::iterator i = s->args.begin();
+         i != s->args.end(); ++i) {
+      if ((*i)->is(Fn_Arg::ALT)) {
+        collect_calls((*i)->alt_ref(), calls);
+      }
+    }
+  } else if (a->is(Alt::LINK)) {
+    Alt::Link *l = dynamic_cast<Alt::Link*>(a);
+    if (l->nt->is(Symbol::NONTERMINAL)) {
+      calls.insert(dynamic_cast<Symbol::NT*>(l->nt));
+    }
+  } else if (a->is(Alt::BLOCK)) {
+    Alt::Block *b = dynamic_cast<Alt::Block*>(a);
+    for (std::list<Alt::Base*>::iterator i = b->alts.begin();
+         i != b->alts.end(); ++i) {
+      collect_calls(*i, calls);
+    }
+  } else if (a->is(Alt::MULTI)) {
+    Alt::Multi *m = dynamic_cast<Alt::Multi*>(a);
+    for (std::list<Alt::Base*>::const_iterator i = m->components().begin();
+         i != m->components().end(); ++i) {
+      collect_calls(*i, calls);
+    }
+  }
+}
+
+bool Grammar::deep_recursion() const {
+  hashtable<Symbol::NT*, std::set<Symbol::NT*> > calls;
+  for (std::list<Symbol::NT*>::const_iterator i = nt_list.begin();
+       i != nt_list.end(); ++i) {
+    std::set<Symbol::NT*> &c = calls[*i];
+    for (std::list<Alt::Base*>::iterator j = (*i)->alts.begin();
+         j != (*i)->alts.end(); ++j) {
+      collect_calls(*j, c);
+    }
+  }
+  for (hashtable<std::string, Symbol::NT*>::const_iterator i =
+       tabulated.begin(); i != tabulated.end(); ++i) {
+    Symbol::NT *nt = i->second;
+    // a constant table bounds the number of nested calls
+    bool constant = true;
+    for (std::vector<Table>::const_iterator j = nt->tables().begin();
+         j != nt->tables().end(); ++j) {
+      constant = constant && j->type() == Table::CONSTANT;
+    }
+    if (constant) {
+      continue;
+    }
+    std::set<Symbol::NT*> seen;
+    std::vector<Symbol::NT*> todo(calls[nt].begin(), calls[nt].end());
+    while (!todo.empty()) {
+      Symbol::NT *x = todo.back();
+      todo.pop_back();
+      if (x == nt) {
+        return true;
+      }
+      if (!seen.insert(x).second) {
+        continue;
+      }
+      todo.insert(todo.end(), calls[x].begin(), calls[x].end());
+    }
+  }
+  return false;
+}
+
+
 void Grammar::init_calls() {
   for (std::list<Symbol::NT*>::iterator i = nt_list.begin();
        i != nt_list.end(); ++i) {
@@ -533,6 +721,10 @@ const Runtime::Asm::Poly & Grammar::runtime_by_width() {
 
 
 Runtime::Poly Grammar::runtime() {
+  if (!rt_deps_ready) {
+    init_runtime_deps();
+  }
+  clear_cyclic_runtime();
   std::list<Symbol::NT*> active_list;
   Runtime::Poly one(1);
   Runtime::Poly rt;
@@ -545,10 +737,162 @@ Runtime::Poly Grammar::runtime() {
   }
   // put_table_conf(std::cerr);
   // std::cerr << std::endl;
+  clear_cyclic_runtime();
   return rt;
 }
 
 
+namespace {
+
+// collects the non-terminals linked by the alternatives of a
+// non-terminal
+struct Link_Visitor : public Visitor {
+  std::vector<Symbol::NT*> nts;
+
+  void visit(Alt::Link &a) {
+    if (a.nt->is(Symbol::NONTERMINAL)) {
+      Symbol::NT *nt = dynamic_cast<Symbol::NT*>(a.nt);
+      if (std::find(nts.begin(), nts.end(), nt) == nts.end()) {
+        nts.push_back(nt);
+      }
+    }
+  }
+};
+
+}  // namespace
+
+
+void Grammar::init_runtime_deps() {
+  rt_callers.clear();
+  rt_callees.clear();
+  for (hashtable<std::string, Symbol::Base*>::iterator i = NTs.begin();
+       i != NTs.end(); ++i) {
+    if (!i->second->is(Symbol::NONTERMINAL)) {
+      continue;
+    }
+    Symbol::NT *nt = dynamic_cast<Symbol::NT*>(i->second);
+    Link_Visitor v;
+    nt->traverse(v);
+    rt_callees[nt] = v.nts;
+    rt_callers[nt];
+    for (std::vector<Symbol::NT*>::iterator j = v.nts.begin();
+         j != v.nts.end(); ++j) {
+      rt_callers[*j].push_back(nt);
+    }
+  }
+  rt_deps_ready = true;
+}
+
+
+void Grammar::invalidate_runtime(Symbol::NT *nt) {
+  if (!rt_deps_ready) {
+    clear_runtime();
+    return;
+  }
+  // the runtime of a non-terminal includes the runtimes of the
+  // non-tabulated non-terminals it links to, thus the change propagates
+  // to the callers until a tabulated one is reached
+  hashtable<Symbol::NT*, bool> seen;
+  std::vector<Symbol::NT*> stack(rt_callers[nt]);
+  while (!stack.empty()) {
+    Symbol::NT *x = stack.back();
+    stack.pop_back();
+    if (seen[x]) {
+      continue;
+    }
+    seen[x] = true;
+    x->clear_runtime();
+    if (!x->is_tabulated()) {
+      stack.insert(stack.end(), rt_callers[x].begin(), rt_callers[x].end());
+    }
+  }
+}
+
+
+namespace {
+
+// Tarjan's algorithm on the links to non-tabulated non-terminals
+struct Runtime_SCC {
+  hashtable<Symbol::NT*, std::vector<Symbol::NT*> > &callees;
+  hashtable<Symbol::NT*, size_t> index, low;
+  hashtable<Symbol::NT*, bool> on_stack;
+  std::vector<Symbol::NT*> stack;
+  std::vector<Symbol::NT*> cyclic;
+  size_t next;
+
+  explicit Runtime_SCC(hashtable<Symbol::NT*, std::vector<Symbol::NT*> > &c)
+    : callees(c), next(0) {}
+
+  void visit(Symbol::NT *nt) {
+    index[nt] = low[nt] = next++;
+    stack.push_back(nt);
+    on_stack[nt] = true;
+    bool self_loop = false;
+    std::vector<Symbol::NT*> &out = callees[nt];
+    for (std::vector<Symbol::NT*>::iterator i = out.begin();
+         i != out.end(); ++i) {
+      if ((*i)->is_tabulated()) {
+        continue;
+      }
+      if (*i == nt) {
+        self_loop = true;
+      }
+      if (index.find(*i) == index.end()) {
+        visit(*i);
+        low[nt] = std::min(low[nt], low[*i]);
+      } else if (on_stack[*i]) {
+        low[nt] = std::min(low[nt], index[*i]);
+      }
+    }
+    if (low[nt] != index[nt]) {
+      return;
+    }
+    std::vector<Symbol::NT*>::iterator b = std::find(stack.begin(),
+                                                     stack.end(), nt);
+    if (self_loop || stack.end() - b > 1) {
+      cyclic.insert(cyclic.end(), b, stack.end());
+    }
+    for (std::vector<Symbol::NT*>::iterator i = b; i != stack.end(); ++i) {
+      on_stack[*i] = false;
+    }
+    stack.erase(b, stack.end());
+  }
+};
+
+}  // namespace
+
+
+/*
+   The runtime of a non-terminal that reaches a cycle of non-tabulated
+   non-terminals depends on the non-terminal the analysis enters the
+   cycle from (see Symbol::NT::set_recs), i.e. on the call order of a
+   runtime() call; thus these are not memoized between calls.
+*/
+void Grammar::clear_cyclic_runtime() {
+  Runtime_SCC scc(rt_callees);
+  for (hashtable<Symbol::NT*, std::vector<Symbol::NT*> >::iterator i =
+       rt_callees.begin(); i != rt_callees.end(); ++i) {
+    if (scc.index.find(i->first) == scc.index.end()) {
+      scc.visit(i->first);
+    }
+  }
+  hashtable<Symbol::NT*, bool> seen;
+  std::vector<Symbol::NT*> &stack = scc.cyclic;
+  while (!stack.empty()) {
+    Symbol::NT *x = stack.back();
+    stack.pop_back();
+    if (seen[x]) {
+      continue;
+    }
+    seen[x] = true;
+    x->clear_runtime();
+    if (!x->is_tabulated()) {
+      stack.insert(stack.end(), rt_callers[x].begin(), rt_callers[x].end());
+    }
+  }
+}
+
+
 bool Grammar::set_tabulated(std::vector<std::string> &v) {
   bool r = true;
   for (std::vector<std::string>::iterator i = v.begin(); i != v.end(); ++i) {
@@ -568,11 +912,43 @@ bool Grammar::set_tabulated(std::vector<std::string> &v) {
 }
 
 
+bool Grammar::set_sparse_tables(const std::vector<std::string> &v) {
+  bool r = true;
+  for (std::vector<std::string>::const_iterator i = v.begin();
+       i != v.end(); ++i) {
+    hashtable<std::string, Symbol::Base*>::iterator a = NTs.find(*i);
+    if (a == NTs.end() || a->second->is(Symbol::TERMINAL)) {
+      Log::instance()->error(
+        "Cannot set NT " + (*i) + " as sparse table - it is not defined.");
+      r = false;
+    } else {
+      dynamic_cast<Symbol::NT*>(a->second)->set_sparse_table(true);
+    }
+  }
+  return r;
+}
+
+void Grammar::set_soa_tables() {
+  for (std::list<Symbol::NT*>::iterator i = nt_list.begin();
+       i != nt_list.end(); ++i) {
+    (*i)->set_soa_table(true);
+  }
+}
+
+void Grammar::set_fixed_tables(size_t n) {
+  for (std::list<Symbol::NT*>::iterator i = nt_list.begin();
+       i != nt_list.end(); ++i) {
+    (*i)->set_fixed_table(n);
+  }
+}
+
+
 void Grammar::clear_runtime() {
   for (hashtable<std::string, Symbol::Base*>::iterator i = NTs.begin();
        i != NTs.end(); ++i) {
     i->second->clear_runtime();
   }
+  rt_deps_ready = false;
 }
 
 
@@ -590,9 +966,9 @@ void Grammar::set_tabulated(hashtable<std::string, Symbol::NT*> &temp) {
 
 
 void Grammar::set_tabulated(Symbol::Base *nt) {
-  clear_runtime();
-  nt->set_tabulated();
   assert(nt->is(Symbol::NONTERMINAL));
+  invalidate_runtime(dynamic_cast<Symbol::NT*>(nt));
+  nt->set_tabulated();
   if (!nt->never_tabulate()) {
     tabulated[*nt->name] = dynamic_cast<Symbol::NT*>(nt);
   }
@@ -609,6 +985,13 @@ void Grammar::clear_tabulated() {
 }
 
 
+void Grammar::clear_tabulated(Symbol::NT *nt) {
+  invalidate_runtime(nt);
+  nt->set_tabulated(false);
+  tabulated.erase(*nt->name);
+}
+
+
 void Grammar::set_all_tabulated() {
   clear_runtime();
   for (hashtable<std::string, Symbol::Base*>::iterator i = NTs.begin();
@@ -713,6 +1096,115 @@ void Grammar::approx_table_conf(bool opt_const, unsigned int const_div) {
     set_tabulated(*i);
     r = runtime();
   }
+  // later passes rewrite the grammar, thus the link graph is rebuilt
+  // on the next runtime analysis
+  rt_deps_ready = false;
+}
+
+
+namespace {
+
+struct Profile_Gain_Cmp {
+  const Table_Profile &profile;
+
+  explicit Profile_Gain_Cmp(const Table_Profile &p) : profile(p) {}
+
+  // saved re-computations per allocated byte
+  double gain(const Symbol::NT *nt) const {
+    const Table_Profile::Entry *e = profile.find(*nt->name);
+    assert(e);
+    return static_cast<double>(e->hits) /
+      static_cast<double>(std::max(e->bytes, uint64_t(1)));
+  }
+
+  bool operator()(const Symbol::NT *a, const Symbol::NT *b) const {
+    return gain(a) > gain(b);
+  }
+};
+
+}  // namespace
+
+
+void Grammar::profile_table_conf(const Table_Profile &profile,
+                                 uint64_t budget) {
+  approx_table_conf();
+  Runtime::Asm::Poly opt;
+  opt = runtime();
+
+  std::vector<Symbol::NT*> nts;
+  for (std::list<Symbol::NT*>::iterator i = nt_list.begin();
+       i != nt_list.end(); ++i) {
+    if (profile.find(*(*i)->name) && !(*i)->never_tabulate()) {
+      nts.push_back(*i);
+    }
+  }
+  Profile_Gain_Cmp cmp(profile);
+  std::stable_sort(nts.begin(), nts.end(), cmp);
+
+  // a table that is never read twice only costs time and memory
+  uint64_t mem = 0;
+  for (std::vector<Symbol::NT*>::iterator i = nts.begin();
+       i != nts.end(); ++i) {
+    if (!(*i)->is_tabulated()) {
+      continue;
+    }
+    const Table_Profile::Entry *e = profile.find(*(*i)->name);
+    if (e->hits == 0) {
+      clear_tabulated(*i);
+      if (opt == runtime()) {
+        continue;
+      }
+      set_tabulated(*i);
+    }
+    mem += e->bytes;
+  }
+
+  if (budget && mem > budget) {
+    std::ostringstream o;
+    o << "The asymptotically optimal table configuration needs " << mem
+      << " bytes for the profiled input length " << profile.n
+      << ", which exceeds the table memory budget of " << budget
+      << " bytes. Dropping the tables with the least re-use.";
+    Log::instance()->warning(o.str());
+    for (std::vector<Symbol::NT*>::reverse_iterator i = nts.rbegin();
+         i != nts.rend() && mem > budget; ++i) {
+      if ((*i)->is_tabulated()) {
+        clear_tabulated(*i);
+        mem -= profile.find(*(*i)->name)->bytes;
+      }
+    }
+  }
+
+  // use the remaining memory for the tables that save the most
+  // re-computations per byte
+  for (std::vector<Symbol::NT*>::iterator i = nts.begin();
+       i != nts.end(); ++i) {
+    const Table_Profile::Entry *e = profile.find(*(*i)->name);
+    if ((*i)->is_tabulated() || e->hits == 0) {
+      continue;
+    }
+    if (budget && mem + e->bytes > budget) {
+      continue;
+    }
+    if (Log::instance()->is_debug()) {
+      std::cerr << "## " << *(*i)->name << " (" << e->hits
+        << " hits)" << std::endl;
+    }
+    set_tabulated(*i);
+    mem += e->bytes;
+  }
+
+  // below this ratio of computed cells, the hashed Table::Sparse
+  // storage needs less memory than the dense one
+  const double sparse_fill = 0.05;
+  for (std::vector<Symbol::NT*>::iterator i = nts.begin();
+       i != nts.end(); ++i) {
+    if ((*i)->is_tabulated() &&
+        profile.find(*(*i)->name)->fill() < sparse_fill) {
+      (*i)->set_sparse_table(true);
+    }
+  }
+  rt_deps_ready = false;
 }
 
 
@@ -967,7 +1459,30 @@ void Grammar::init_decls(const std::string &prefix) {
 }
 
 
+void Grammar::init_split_reductions(AST &ast) {
+  for (hashtable<std::string, Symbol::NT*>::iterator i = tabulated.begin();
+       i != tabulated.end(); ++i) {
+    i->second->set_row_access(false);
+    i->second->set_column_access(false);
+  }
+  for (hashtable<std::string, Symbol::Base*>::iterator i = NTs.begin();
+       i != NTs.end(); ++i) {
+    Symbol::NT *nt = dynamic_cast<Symbol::NT*>(i->second);
+    if (!nt) {
+      continue;
+    }
+    for (std::list<Alt::Base*>::iterator j = nt->alts.begin();
+         j != nt->alts.end(); ++j) {
+      if ((*j)->is(Alt::SIMPLE)) {
+        dynamic_cast<Alt::Simple*>(*j)->init_split_reduce(ast, *nt);
+      }
+    }
+  }
+}
+
+
 void Grammar::codegen(AST &ast) {
+  init_split_reductions(ast);
   for (hashtable<std::string, Symbol::Base*>::iterator i = NTs.begin();
        i != NTs.end(); ++i) {
     Symbol::NT *nt = dynamic_cast<Symbol::NT*>(i->second);
@@ -978,11 +1493,13 @@ void Grammar::codegen(AST &ast) {
 }
 
 
-void Grammar::print_code(Printer::Base &out) {
+void Grammar::print_code(Printer::Base &out, size_t part, size_t parts) {
+  assert(part < parts);
+  size_t k = 0;
   for (hashtable<std::string, Symbol::Base*>::iterator i = NTs.begin();
        i != NTs.end(); ++i) {
     Symbol::NT *nt = dynamic_cast<Symbol::NT*>(i->second);
-    if (nt) {
+    if (nt && (k++ % parts) == part) {
       std::list<Fn_Def*> &l = nt->code_list();
       for (std::list<Fn_Def*>::iterator i = l.begin(); i != l.end(); ++i) {
         out << **i;
@@ -45,6 +45,7 @@ class Signature_Base;
 class Visitor;
 class AST;
 class Algebra;
+class Table_Profile;
 
 
 class Grammar {
@@ -67,6 +68,17 @@ class Grammar {
   /* Flag this Grammar as being converted into an outside version */
   bool _is_partof_outside = false;
 
+  // Link graph of the non-terminals for the incremental runtime
+  // analysis: toggling the tabulation of a non-terminal only clears the
+  // memoized runtimes of the non-terminals that reach it via links to
+  // non-tabulated non-terminals.
+  hashtable<Symbol::NT*, std::vector<Symbol::NT*> > rt_callers;
+  hashtable<Symbol::NT*, std::vector<Symbol::NT*> > rt_callees;
+  bool rt_deps_ready = false;
+  void init_runtime_deps();
+  void invalidate_runtime(Symbol::NT *nt);
+  void clear_cyclic_runtime();
+
  public:
   // The name of the grammar as defined in the grammar name of
   // the gap-source-code file.
@@ -142,6 +154,16 @@ class Grammar {
 
   void init_table_dims();
   void window_table_dims();
+  // gapc --linear-space: the maximal distance in d of the row, i.e. the
+  // left index of track 0, of a cell of a tabulated NT to the rows of the
+  // tabulated cells it depends on; false, if a tabulated NT doesn't span
+  // all tracks with a track 0 table of free left index only, or if the
+  // distance is unbounded
+  bool row_distance(size_t &d) const;
+  // gapc --auto-cyk: true, if a tabulated NT with a non-constant table
+  // calls itself via other NTs, i.e. if the depth of the top-down
+  // recursion grows with the input length
+  bool deep_recursion() const;
 
   void init_calls();
 
@@ -155,18 +177,34 @@ class Grammar {
 
   const Runtime::Asm::Poly & runtime_by_width();
 
+  // Runtime of the current table configuration. The runtimes of the
+  // non-terminals are memoized between calls, as long as no table in
+  // their call cone is toggled.
   Runtime::Poly runtime();
 
   void clear_runtime();
 
   bool set_tabulated(std::vector<std::string> &v);
   void clear_tabulated();
+  void clear_tabulated(Symbol::NT *nt);
+  // uses Table::Sparse storage for the tables of these non-terminals
+  bool set_sparse_tables(const std::vector<std::string> &v);
+  // uses Table::SoA storage for the tables of pair typed non-terminals
+  void set_soa_tables();
+  // uses Table::Fixed storage sized for inputs of length n
+  void set_fixed_tables(size_t n);
 
   void init_in_out();
   void set_tabulated(hashtable<std::string, Symbol::NT*> &temp);
   void set_all_tabulated();
   Runtime::Poly asm_opt_runtime();
   void approx_table_conf(bool opt_const = true, unsigned int const_div = 5);
+  // Starts from approx_table_conf() and uses the measured lookups of
+  // a profiling run to drop tables without re-use and to add tables
+  // that save the most re-computations per byte, as long as the tables
+  // fit into budget bytes (0 means no limit). Tables with a low fill
+  // ratio get sparse storage.
+  void profile_table_conf(const Table_Profile &profile, uint64_t budget);
   void put_table_conf(std::ostream &s);
   void set_tabulated(Symbol::Base *nt);
 
@@ -193,8 +231,11 @@ class Grammar {
   void init_decls();
   void init_decls(const std::string &prefix);
 
+  // marks the fused split reductions of the CYK code, see
+  // Alt::Simple::init_split_reduce
+  void init_split_reductions(AST &ast);
   void codegen(AST &ast);
-  void print_code(Printer::Base &out);
+  void print_code(Printer::Base &out, size_t part = 0, size_t parts = 1);
 
   void print_dot(std::ostream &out);
 
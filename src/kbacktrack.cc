@@ -250,6 +250,12 @@ void KBacktrack::gen_nt_proxy_fn(Fn_Def *fn, Type::Base *score_return_type) {
   set_value->add_arg(*tupel);
   body->push_back(set_value);
 
+  // the back end serves only the scores of its fronts
+  Statement::Fn_Call *expect = new Statement::Fn_Call("expect_score");
+  expect->add_arg(*bt_decl);
+  expect->add_arg(new Var_Acc::Comp(*tupel, 0));
+  body->push_back(expect);
+
   if (is_list) {
     Statement::Fn_Call *push_back = new Statement::Fn_Call(
         Statement::Fn_Call::PUSH_BACK);
@@ -85,6 +85,25 @@ bool Options::check() {
   if (window_mode && cyk)
     Log::instance()->error(
       "Currently --window-mode is just possible without --cyk.");
+  if (window_mode && auto_cyk)
+    Log::instance()->error("Can't combine --auto-cyk with --window-mode");
+
+  if (band && window_mode)
+    Log::instance()->error("Can't combine --band with --window-mode");
+  if (band && checkpointing)
+    Log::instance()->error("Can't combine --band with --checkpoint");
+
+  // --auto-cyk switches to cyk code for --linear-space
+  if (linear_space && !cyk && !auto_cyk)
+    Log::instance()->error("--linear-space needs --cyk or --auto-cyk");
+  if (linear_space && (checkpointing || subopt || classified))
+    Log::instance()->error("Can't combine --linear-space with --checkpoint, "
+                           "--subopt or --subopt-classify");
+  if (linear_space && (soa_tables || fixed_size || !sparse_tab_list.empty()))
+    Log::instance()->error("Can't combine --linear-space with --soa-tables, "
+                           "--fixed-size or --sparse-tab");
+  if (cyk && !sparse_tab_list.empty())
+    Log::instance()->error("Can't combine --sparse-tab with --cyk");
 
   if (classified && kbest)
     Log::instance()->error("Use either --subopt-classify or --kbest");
@@ -112,6 +131,16 @@ bool Options::check() {
   if (specialization == 2 &&  step_option == 1)
     Log::instance()->error("Step mode is not supported for sorted ADP.");
 
+  if (table_memory > 0 && table_profile.empty())
+    Log::instance()->error("--table-memory needs --table-profile");
+
+  if (split_code > 0 && out_file.empty())
+    Log::instance()->error("Can't combine --stdout with --split-code");
+
+  if (split_code > 0 && specialization > 0)
+    Log::instance()->error(
+      "--split-code is not supported for specialized ADP.");
+
   if (float_acc < 0) {
     Log::instance()->error(
       "Floating point accuracy must be greater then 0 digits");
@@ -30,6 +30,7 @@
 #include <iostream>
 #include <ostream>
 #include <fstream>
+#include <boost/cstdint.hpp>
 
 #include <cassert>
 
@@ -42,13 +43,19 @@ std::string remove_dir(const std::string &f);
 struct Options {
   Options()
     :  inline_nts(false), out(NULL), h_stream_(NULL), m_stream_(NULL),
-      approx_table_design(false), tab_everything(false),
-      cyk(false), backtrack(false), sample(false), subopt(false),
+      approx_table_design(false), tab_everything(false), table_memory(0),
+      cyk(false), auto_cyk(false), backtrack(false), sample(false),
+      subopt(false),
       kbacktrack(false),
+      soa_tables(false),
+      fixed_size(0),
+      band(false),
+      linear_space(false),
       no_coopt(false),
       no_coopt_class(false),
       classified(false),
       window_mode(false),
+      no_compact_subseq(false),
       kbest(false),
       ambiguityCheck(false),
       specializeGrammar(false),
@@ -58,7 +65,9 @@ struct Options {
       float_acc(0),
       specialization(0), step_option(0),
       plot_grammar(0), plotgrammar_stream_(NULL),
-      checkpointing(false) {
+      checkpointing(false),
+      split_code(0),
+      time_passes(false), memory_passes(false) {
     // start with no requested outside NTs, i.e. no outside generation
     outside_nt_list.clear();
   }
@@ -73,6 +82,11 @@ struct Options {
     m_stream_ = NULL;
     delete plotgrammar_stream_;
     plotgrammar_stream_ = NULL;
+    for (std::vector<std::ostream*>::iterator i = split_streams_.begin();
+         i != split_streams_.end(); ++i) {
+      delete *i;
+    }
+    split_streams_.clear();
   }
 
 
@@ -91,18 +105,41 @@ struct Options {
 
   bool approx_table_design;
   bool tab_everything;
+  // measured table usage, see table_profile.hh
+  std::string table_profile;
+  // memory budget in MB for --table-profile, 0 means no limit
+  uint64_t table_memory;
   bool cyk;
+  // switch to cyk, if the top-down recursion depth grows with the input,
+  // see Grammar::deep_recursion
+  bool auto_cyk;
   bool backtrack;
   bool sample;
   bool subopt;
   bool kbacktrack;
   std::vector<std::string> tab_list;
+  std::vector<std::string> sparse_tab_list;
+  // structure of arrays storage for the tables of pair typed answers
+  bool soa_tables;
+  // maximal input length, up to which the tables are kept inside of the
+  // generated class instead of on the heap; 0: no limit
+  size_t fixed_size;
+  // restrict multi-track tables to a band around the diagonal, whose
+  // width is a runtime option
+  bool band;
+  // keep only some rows of track 0 of the tables, which the backtrace
+  // recomputes, see AST::linear_space
+  bool linear_space;
   bool no_coopt;
   bool no_coopt_class;
   bool classified;
 
   bool window_mode;
 
+  // keep the sequence pointer in every Subsequence object, e.g. for
+  // user headers that compare or null it
+  bool no_compact_subseq;
+
   std::vector<std::string> includes;
 
   bool kbest;
@@ -215,6 +252,31 @@ struct Options {
   // provide option to enable checkpointing routine integration
   bool checkpointing;
 
+  // number of additional translation units the non-terminal functions
+  // are distributed over, such that the generated code can be compiled
+  // in parallel (0 = all code goes into out_file)
+  unsigned int split_code;
+  std::vector<std::string> split_files;
+  std::vector<std::ostream*> split_streams_;
+
+  // report the time and memory usage of the compiler passes on stderr
+  bool time_passes;
+  bool memory_passes;
+
+  std::ostream &split_stream(size_t k) {
+    assert(k < split_files.size());
+    if (split_streams_.size() <= k) {
+      split_streams_.resize(split_files.size(), NULL);
+    }
+    if (!split_streams_[k]) {
+      split_streams_[k] = new std::ofstream(split_files[k].c_str());
+      split_streams_[k]->exceptions(std::ios_base::badbit |
+                                    std::ios_base::failbit |
+                                    std::ios_base::eofbit);
+    }
+    return *split_streams_[k];
+  }
+
   bool check();
 };
 
@@ -0,0 +1,149 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+
+#include "pass_report.hh"
+
+
+void Pass_Report::begin(const std::string &name) {
+  if (!enabled()) {
+    return;
+  }
+  Start s;
+  s.entry = entries.size();
+  entries.push_back(Entry(name, open.size()));
+  s.wall = wall_seconds();
+  s.cpu = cpu_seconds();
+  s.rss = memory_ ? rss_kib() : 0;
+  open.push_back(s);
+}
+
+
+void Pass_Report::end() {
+  if (!enabled()) {
+    return;
+  }
+  assert(!open.empty());
+  const Start &s = open.back();
+  Entry &e = entries[s.entry];
+  e.wall = wall_seconds() - s.wall;
+  e.cpu = cpu_seconds() - s.cpu;
+  if (memory_) {
+    e.rss = rss_kib();
+    e.delta = e.rss - s.rss;
+    // ru_maxrss may lag behind on some kernels
+    e.peak = std::max(peak_rss_kib(), e.rss);
+  }
+  open.pop_back();
+}
+
+
+void Pass_Report::print(std::ostream &o) const {
+  double total = 0;
+  for (std::vector<Entry>::const_iterator i = entries.begin();
+       i != entries.end(); ++i) {
+    if (i->depth == 0) {
+      total += i->wall;
+    }
+  }
+  std::ios_base::fmtflags flags = o.flags();
+  std::streamsize precision = o.precision();
+  o << std::fixed;
+  if (time_) {
+    o << "=== gapc pass execution times (total " << std::setprecision(3)
+      << total << " s) ===\n"
+      << "     wall s      cpu s  wall %   pass\n";
+    for (std::vector<Entry>::const_iterator i = entries.begin();
+         i != entries.end(); ++i) {
+      o << std::setw(11) << std::setprecision(3) << i->wall
+        << std::setw(11) << i->cpu
+        << std::setw(8) << std::setprecision(1)
+        << (total > 0 ? 100 * i->wall / total : 0)
+        << "   " << std::string(2 * i->depth, ' ') << i->name << '\n';
+    }
+  }
+  if (memory_) {
+    o << "=== gapc pass memory usage (peak " << peak_rss_kib()
+      << " KiB) ===\n"
+      << "    rss KiB  delta KiB   peak KiB   pass\n";
+    for (std::vector<Entry>::const_iterator i = entries.begin();
+         i != entries.end(); ++i) {
+      o << std::setw(11) << i->rss
+        << std::setw(11) << std::showpos << i->delta << std::noshowpos
+        << std::setw(11) << i->peak
+        << "   " << std::string(2 * i->depth, ' ') << i->name << '\n';
+    }
+  }
+  o.flags(flags);
+  o.precision(precision);
+}
+
+
+double Pass_Report::wall_seconds() {
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+double Pass_Report::cpu_seconds() {
+  struct rusage u;
+  getrusage(RUSAGE_SELF, &u);
+  return u.ru_utime.tv_sec + u.ru_utime.tv_usec / 1e6 +
+    u.ru_stime.tv_sec + u.ru_stime.tv_usec / 1e6;
+}
+
+
+int64_t Pass_Report::rss_kib() {
+  // resident pages are the second field of statm
+  FILE *f = std::fopen("/proc/self/statm", "r");
+  if (!f) {
+    return peak_rss_kib();
+  }
+  long size = 0, resident = 0;
+  int r = std::fscanf(f, "%ld %ld", &size, &resident);
+  std::fclose(f);
+  if (r != 2) {
+    return peak_rss_kib();
+  }
+  return static_cast<int64_t>(resident) * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+
+int64_t Pass_Report::peak_rss_kib() {
+  struct rusage u;
+  getrusage(RUSAGE_SELF, &u);
+#ifdef __APPLE__
+  // bytes on macOS
+  return u.ru_maxrss / 1024;
+#else
+  return u.ru_maxrss;
+#endif
+}
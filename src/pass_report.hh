@@ -0,0 +1,107 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#ifndef SRC_PASS_REPORT_HH_
+#define SRC_PASS_REPORT_HH_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+// Wall time, CPU time and memory usage of the compiler passes, as printed
+// to stderr with --time-passes and --memory-passes. Passes are started and
+// ended in a nested fashion, e.g. the codegen pass of the back end; the
+// report lists them in the order they were started.
+class Pass_Report {
+ public:
+  struct Entry {
+    std::string name;
+    unsigned depth;
+    // seconds
+    double wall;
+    double cpu;
+    // resident set size at the end of the pass, its change during the
+    // pass and the peak resident set size so far, all in KiB
+    int64_t rss;
+    int64_t delta;
+    int64_t peak;
+
+    Entry(const std::string &n, unsigned d)
+      : name(n), depth(d), wall(0), cpu(0), rss(0), delta(0), peak(0) {}
+  };
+
+  // the pass name covers the enclosing scope
+  class Scope {
+   private:
+    Pass_Report &report;
+
+   public:
+    Scope(Pass_Report &r, const std::string &name) : report(r) {
+      report.begin(name);
+    }
+    ~Scope() {
+      report.end();
+    }
+  };
+
+ private:
+  bool time_;
+  bool memory_;
+
+  std::vector<Entry> entries;
+
+  struct Start {
+    size_t entry;
+    double wall;
+    double cpu;
+    int64_t rss;
+  };
+  std::vector<Start> open;
+
+ public:
+  Pass_Report() : time_(false), memory_(false) {}
+
+  void enable(bool time, bool memory) {
+    time_ = time;
+    memory_ = memory;
+  }
+  bool enabled() const { return time_ || memory_; }
+
+  void begin(const std::string &name);
+  void end();
+
+  const std::vector<Entry> &passes() const { return entries; }
+
+  // prints the enabled reports
+  void print(std::ostream &o) const;
+
+  static double wall_seconds();
+  static double cpu_seconds();
+  // current and peak resident set size of the process in KiB
+  static int64_t rss_kib();
+  static int64_t peak_rss_kib();
+};
+
+#endif  // SRC_PASS_REPORT_HH_
@@ -44,7 +44,9 @@ Table_Decl::Table_Decl(
   nt_(nt),
   type_(t),
   pos_type_(0),
-  name_(n), cyk_(c),
+  name_(n), cyk_(c), sparse_(false), soa_(false),
+  fixed_cells_(0), band_(false), rows_(false),
+  row_access_(false), column_access_(false),
   fn_is_tab_(fn_is_tab),
   fn_untab_(0),
   fn_tab_(fn_tab),
@@ -44,6 +44,13 @@ class Table_Decl : public Base {
   ::Type::Base *pos_type_;
   std::string *name_;
   bool cyk_;
+  bool sparse_;
+  bool soa_;
+  size_t fixed_cells_;
+  bool band_;
+  bool rows_;
+  bool row_access_;
+  bool column_access_;
 
   Fn_Def *fn_is_tab_;
   Fn_Def *fn_untab_;
@@ -70,6 +77,30 @@ class Table_Decl : public Base {
   const ::Type::Base &datatype() const { assert(type_); return *type_; }
   const ::Type::Base &pos_type() const { assert(pos_type_); return *pos_type_; }
   bool cyk() const { return cyk_; }
+  // store the cells in a Table::Sparse instead of a std::vector
+  bool sparse() const { return sparse_; }
+  void set_sparse(bool b) { sparse_ = b; }
+  // store the pair typed cells in a Table::SoA, get() returns by value
+  bool soa() const { return soa_; }
+  void set_soa(bool b) { soa_ = b; }
+  // store up to this many cells in a Table::Fixed, or 0
+  size_t fixed_cells() const { return fixed_cells_; }
+  void set_fixed_cells(size_t n) { fixed_cells_ = n; }
+  // cells outside of the band (gapc --band) are not stored, the table
+  // is initialized with the band width
+  bool band() const { return band_; }
+  void set_band(bool b) { band_ = b; }
+  // store the cells in a Table::Rows (gapc --linear-space), the table is
+  // initialized with the Table::Row_Blocks of the program
+  bool rows() const { return rows_; }
+  void set_rows(bool b) { rows_ = b; }
+  // row(i) points to the cells (i, k) of a transposed copy of the
+  // array, column(j) to the cells (k, j) of the array, both indexed
+  // by k, see Alt::Simple::init_split_reduce
+  bool row_access() const { return row_access_; }
+  void set_row_access(bool b) { row_access_ = b; }
+  bool column_access() const { return column_access_; }
+  void set_column_access(bool b) { column_access_ = b; }
   const std::list<Statement::Var_Decl*> &ns() const { return ns_; }
 
   const Fn_Def &fn_is_tab() const { return *fn_is_tab_; }
@@ -81,6 +81,11 @@ Symbol::NT::NT(std::string *n, const Loc &l)
     eval_fn(NULL), eval_decl(NULL),
                 eval_nullary_fn(NULL), specialised_comparator_fn(NULL),
                 specialised_sorter_fn(NULL), marker(NULL),
+    sparse_table_(false),
+    soa_table_(false),
+    fixed_table_(0),
+    row_access_(false),
+    column_access_(false),
     ret_decl(NULL), table_decl(NULL),
     zero_decl(0) {
 }
@@ -772,12 +777,12 @@ Statement::Base *Symbol::NT::build_return_empty(const Code::Mode &mode) {
   return new Statement::Return(new Expr::Vacc(*zero_decl));
 }
 
-void Symbol::NT::init_guards(Code::Mode mode) {
+void Symbol::NT::init_guards(Code::Mode mode, bool with_ys_guards) {
   guards.clear();
 
   std::list<Expr::Base*> cond_list;
   // else, guards are generated in tablegen.cc
-  if (!tabulated || mode == Code::Mode::CYK)
+  if (with_ys_guards && (!tabulated || mode == Code::Mode::CYK))
     gen_ys_guards(cond_list);
   marker_cond(mode, cond_list);
 
@@ -794,6 +799,12 @@ void Symbol::NT::init_guards(Code::Mode mode) {
 }
 
 void Symbol::NT::gen_ys_guards(std::list<Expr::Base*> &ors) const {
+  gen_ys_guards(ors, left_indices, right_indices);
+}
+
+void Symbol::NT::gen_ys_guards(std::list<Expr::Base*> &ors,
+                               const std::vector<Expr::Base*> &left,
+                               const std::vector<Expr::Base*> &right) const {
   size_t t = 0;
   // std::vector<Table>::const_iterator b = tables_.begin();
   for (Yield::Multi::const_iterator a = m_ys.begin();
@@ -802,7 +813,7 @@ void Symbol::NT::gen_ys_guards(std::list<Expr::Base*> &ors) const {
     const Yield::Size &y = *a;
     // const Table &table = *b;
 
-    Expr::Base *i = left_indices[t], *j = right_indices[t];
+    Expr::Base *i = left[t], *j = right[t];
 
     Expr::Base *size = new Expr::Minus(j, i);
 
@@ -815,6 +826,23 @@ void Symbol::NT::gen_ys_guards(std::list<Expr::Base*> &ors) const {
   }
 }
 
+void Symbol::NT::gen_band_guards(std::list<Expr::Base*> &ors,
+                                 const std::vector<Expr::Base*> &left,
+                                 const std::vector<Expr::Base*> &right,
+                                 Expr::Base *band) const {
+  const Table &first = table_dims[0];
+  for (size_t t = 1; t < tracks(); ++t) {
+    if (!first.delete_left_index() && !table_dims[t].delete_left_index()) {
+      ors.push_back(new Expr::Greater(left[0], left[t]->plus(band)));
+      ors.push_back(new Expr::Greater(left[t], left[0]->plus(band)));
+    }
+    if (!first.delete_right_index() && !table_dims[t].delete_right_index()) {
+      ors.push_back(new Expr::Greater(right[0], right[t]->plus(band)));
+      ors.push_back(new Expr::Greater(right[t], right[0]->plus(band)));
+    }
+  }
+}
+
 void Symbol::NT::put_guards(std::ostream &s) {
   s << *name << " = ";
   Printer::CC printer;
@@ -1077,8 +1105,29 @@ void Symbol::NT::init_table_decl(const AST &ast) {
 
   Tablegen tg;
   tg.set_window_mode(ast.window_mode);
+  bool checkpoint = ast.checkpoint && !ast.checkpoint->is_buddy;
+  // the OpenMP cyk loops fill a table from several threads, while
+  // Table::Sparse grows its index on insert
+  bool sparse = sparse_table() && !checkpoint && !ast.window_mode &&
+    !ast.cyk();
+  bool soa = soa_table() && !checkpoint && !ast.window_mode && !sparse;
+  tg.set_soa(soa);
+  tg.set_band(ast.banded);
+  tg.set_rows(ast.linear_space);
+  tg.set_transposed(row_access());
   table_decl = tg.create(*this, t, ast.code_mode() == Code::Mode::CYK,
-                         ast.checkpoint && !ast.checkpoint->is_buddy);
+                         checkpoint);
+  // checkpoints archive the dense array, window mode rotates the
+  // cells of a dense window
+  table_decl->set_sparse(sparse);
+  table_decl->set_soa(soa);
+  table_decl->set_band(ast.banded && tracks() > 1);
+  table_decl->set_rows(ast.linear_space);
+  table_decl->set_row_access(row_access());
+  table_decl->set_column_access(column_access());
+  if (fixed_table_ && !checkpoint && !ast.window_mode && !sparse && !soa) {
+    table_decl->set_fixed_cells(Tablegen::cells(tables(), fixed_table_));
+  }
 }
 
 #include <boost/algorithm/string/replace.hpp>
@@ -1117,6 +1166,10 @@ void Symbol::NT::init_table_code(const Code::Mode &mode) {
   }
   start.push_back(if_tab);
   if (mode == Code::Mode::FORWARD || mode == Code::Mode::SUBOPT) {
+    // counts the saved re-computations with -DTABLE_PROFILE
+    Statement::Fn_Call *hit = new Statement::Fn_Call("TABLE_PROFILE_HIT");
+    hit->add_arg(*table_decl);
+    if_tab->then.push_back(hit);
     Expr::Fn_Call *get_tab = new Expr::Fn_Call(Expr::Fn_Call::GET_TABULATED);
     get_tab->add(*table_decl);
     Statement::Return *tab = new Statement::Return( get_tab);
@@ -1130,9 +1183,16 @@ void Symbol::NT::init_table_code(const Code::Mode &mode) {
 }
 
 void Symbol::NT::add_cyk_stub(AST &ast) {
-  ::Type::Base *dt = new ::Type::Referencable(datatype);
+  ::Type::Base *dt = datatype;
+  if (!table_decl->soa()) {
+    dt = new ::Type::Referencable(datatype);
+  }
   Fn_Def *f = new Fn_Def(dt, new std::string("nt_" + *name));
   f->add_para(*this);
+  // the cyk loops computed the cell before, i.e. every call is a hit
+  Statement::Fn_Call *hit = new Statement::Fn_Call("TABLE_PROFILE_HIT");
+  hit->add_arg(*table_decl);
+  f->stmts.push_back(hit);
   Expr::Fn_Call *get_tab = new Expr::Fn_Call(Expr::Fn_Call::GET_TABULATED);
   get_tab->add(*table_decl);
   Statement::Return *tab = new Statement::Return( get_tab);
@@ -1222,7 +1282,7 @@ void Symbol::NT::codegen(AST &ast) {
   init_table_decl(ast);
   init_zero_decl();
   ::Type::Base *dt = datatype;
-  if (tabulated) {
+  if (tabulated && !table_decl->soa()) {
     dt = new ::Type::Referencable(datatype);
   }
   Fn_Def *f = 0;
@@ -1237,7 +1297,10 @@ void Symbol::NT::codegen(AST &ast) {
 
   subopt_header(ast, score_code, f, stmts);
 
-  init_guards(ast.code_mode());
+  // the cyk loops check the yield sizes before calling nt_tabulate_,
+  // see add_nt_calls in cyk.cc
+  init_guards(ast.code_mode(), !(ast.cyk() && tabulated &&
+                                 ast.code_mode() != Code::Mode::BACKTRACK));
   init_table_code(ast.code_mode());
 
   stmts.insert(stmts.begin(), guards.begin(), guards.end());
@@ -1602,6 +1665,33 @@ Symbol::NT *Symbol::NT::clone(size_t track_pos, bool keepname) {
   return nt;
 }
 
+bool Symbol::NT::sparse_table() const {
+  if (sparse_table_) {
+    return true;
+  }
+  for (std::vector<Table>::const_iterator i = table_dims.begin();
+       i != table_dims.end(); ++i) {
+    if (i->type() == Table::QUADRATIC && i->bounded()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Symbol::NT::soa_table() const {
+  if (!soa_table_) {
+    return false;
+  }
+  ::Type::Base *t = datatype->simple();
+  if (!t->is(::Type::TUPLE)) {
+    return false;
+  }
+  ::Type::Tuple *tuple = dynamic_cast< ::Type::Tuple*>(t);
+  assert(tuple->list.size() == 2);
+  return !tuple->list.front()->first->lhs->simple()->is(::Type::LIST) &&
+    !tuple->list.back()->first->lhs->simple()->is(::Type::LIST);
+}
+
 void Symbol::NT::window_table_dim() {
   assert(table_dims.size() == 1);
   Table &table = table_dims[0];
@@ -405,6 +405,63 @@ class NT : public Base {
       return table_dims;
     }
 
+ private:
+    // Table::Sparse storage requested by the user or a table profile
+    bool sparse_table_;
+
+ public:
+    void set_sparse_table(bool b) {
+      sparse_table_ = b;
+    }
+    // true, if only a small fraction of the table cells is computed,
+    // i.e. if requested or if a quadratic table has a constant maximal
+    // yield size, which gives O(n) computed cells
+    bool sparse_table() const;
+
+ private:
+    // Table::SoA storage requested by the user
+    bool soa_table_;
+
+ public:
+    void set_soa_table(bool b) {
+      soa_table_ = b;
+    }
+    // true, if requested and the answer type is a pair of two
+    // non-list types
+    bool soa_table() const;
+
+ private:
+    // input length for Table::Fixed storage requested by the user, or 0
+    size_t fixed_table_;
+
+ public:
+    void set_fixed_table(size_t n) {
+      fixed_table_ = n;
+    }
+    size_t fixed_table() const {
+      return fixed_table_;
+    }
+
+ private:
+    // the cells of a row i or of a column j of the table are read in
+    // one fused split reduction, see Alt::Simple::init_split_reduce
+    bool row_access_;
+    bool column_access_;
+
+ public:
+    void set_row_access(bool b) {
+      row_access_ = b;
+    }
+    bool row_access() const {
+      return row_access_;
+    }
+    void set_column_access(bool b) {
+      column_access_ = b;
+    }
+    bool column_access() const {
+      return column_access_;
+    }
+
 
     void init_table_dim(const Yield::Size &a, const Yield::Size &b,
     std::vector<Yield::Size> &temp_ls,
@@ -447,7 +504,19 @@ class NT : public Base {
         Expr::Vacc *left_most, Expr::Vacc *right_most);
 
     void gen_ys_guards(std::list<Expr::Base*> &ors) const;
-    void init_guards(Code::Mode mode);
+    // yield size guards for the index expressions left and right, e.g. for
+    // the arguments of an nt call in the cyk loops
+    void gen_ys_guards(std::list<Expr::Base*> &ors,
+                       const std::vector<Expr::Base*> &left,
+                       const std::vector<Expr::Base*> &right) const;
+    // band guards (gapc --band) for the index expressions left and right:
+    // the indices of the other tracks differ by more than band from the
+    // same (non deleted) index of the first track
+    void gen_band_guards(std::list<Expr::Base*> &ors,
+                         const std::vector<Expr::Base*> &left,
+                         const std::vector<Expr::Base*> &right,
+                         Expr::Base *band) const;
+    void init_guards(Code::Mode mode, bool with_ys_guards = true);
     void put_guards(std::ostream &s);
 
  private:
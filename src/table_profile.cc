@@ -0,0 +1,74 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#include <fstream>
+#include <sstream>
+
+#include "table_profile.hh"
+#include "log.hh"
+
+
+void Table_Profile::read(std::istream &in, const std::string &file) {
+  std::string line;
+  size_t lineno = 0;
+  while (std::getline(in, line)) {
+    ++lineno;
+    std::istringstream s(line);
+    std::string key;
+    if (!(s >> key) || key[0] == '#') {
+      continue;
+    }
+    bool ok = true;
+    if (key == "n") {
+      ok = static_cast<bool>(s >> n);
+    } else if (key == "nt") {
+      std::string name, a, b, c, d, h;
+      Entry e;
+      ok = static_cast<bool>(s >> name >> a >> e.gets >> h >> e.hits
+                                  >> b >> e.sets >> c >> e.cells
+                                  >> d >> e.bytes) &&
+        a == "gets" && h == "hits" && b == "sets" && c == "cells" &&
+        d == "bytes";
+      if (ok) {
+        nts[name] = e;
+      }
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      std::ostringstream o;
+      o << file << ':' << lineno << ": malformed table profile line: "
+        << line;
+      throw LogError(o.str());
+    }
+  }
+}
+
+
+void Table_Profile::read(const std::string &file) {
+  std::ifstream in(file.c_str());
+  if (!in.good()) {
+    throw LogError("Can't open table profile " + file);
+  }
+  read(in, file);
+}
@@ -0,0 +1,81 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#ifndef SRC_TABLE_PROFILE_HH_
+#define SRC_TABLE_PROFILE_HH_
+
+#include <string>
+#include <iostream>
+#include <boost/cstdint.hpp>
+
+#include "hashtable.hh"
+
+
+// Measured table usage of a generated parser, as written by a binary that
+// was compiled with -DTABLE_PROFILE (see rtlib/table_profile.hh) into the
+// file named by the environment variable GAPC_TABLE_PROFILE. Each line is
+// either
+//   n <input length>
+//   nt <name> gets <lookups> hits <lookups answered from the table>
+//     sets <computed cells> cells <size> bytes <size>
+// where lines starting with # are comments. Only non-terminals that were
+// tabulated in the profiled binary are listed, thus the profiled binary
+// should be generated with --tab-all.
+class Table_Profile {
+ public:
+  struct Entry {
+    uint64_t gets;
+    // number of non-terminal calls that were answered from the table,
+    // i.e. the number of re-computations that tabulation saves
+    uint64_t hits;
+    uint64_t sets;
+    uint64_t cells;
+    uint64_t bytes;
+
+    Entry() : gets(0), hits(0), sets(0), cells(0), bytes(0) {}
+
+    // ratio of computed to allocated cells
+    double fill() const {
+      return cells ? static_cast<double>(sets) / cells : 0;
+    }
+  };
+
+  uint64_t n;
+  hashtable<std::string, Entry> nts;
+
+  Table_Profile() : n(0) {}
+
+  // throws LogError on syntax errors
+  void read(std::istream &in, const std::string &file);
+  void read(const std::string &file);
+
+  const Entry *find(const std::string &nt) const {
+    hashtable<std::string, Entry>::const_iterator i = nts.find(nt);
+    if (i == nts.end()) {
+      return NULL;
+    }
+    return &i->second;
+  }
+};
+
+#endif  // SRC_TABLE_PROFILE_HH_
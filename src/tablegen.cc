@@ -50,7 +50,13 @@ Tablegen::Tablegen()
   dtype(0),
   cyk_(false),
   window_mode_(false),
-  checkpoint_(false) {
+  checkpoint_(false),
+  soa_(false),
+  band_(false),
+  band_first_(0),
+  first_track_(0),
+  rows_(false),
+  transposed_(false) {
   // FIXME?
   type = new ::Type::Size();
 
@@ -118,6 +124,24 @@ void Tablegen::head(Expr::Base *&i, Expr::Base *&j, Expr::Base *&n,
   }
 }
 
+/*
+   In band mode a linear table dimension of a track other than the first
+   one, which has the same free index as the first track, only stores the
+   2 * band + 1 cells around the free index of the first track (the band
+   guards exclude all others). Returns the free index of the first track,
+   if the dimension is stored this way, else NULL.
+*/
+Expr::Base *Tablegen::band_index(size_t track, const Table &table) const {
+  if (!band_first_ || track == first_track_ ||
+      table.type() != Table::LINEAR || band_first_->type() != Table::LINEAR ||
+      table.sticky() != band_first_->sticky()) {
+    return NULL;
+  }
+  std::ostringstream o;
+  o << "t_" << first_track_ << (table.sticky() == Table::LEFT ? "_j" : "_i");
+  return new Expr::Vacc(new std::string(o.str()));
+}
+
 void Tablegen::offset_const(titr track, itr first, const itr &end,
     Expr::Base *dim, Expr::Base *access) {
   std::list<Expr::Base*> ors;
@@ -187,11 +211,19 @@ void Tablegen::offset_left_lin(titr track, itr first, const itr &end,
       ret_zero);
   code.push_back(guard);
 
+  Expr::Base *ext = new Expr::Plus(n, new Expr::Const(1));
+  Expr::Base *x0 = band_index(*track, table);
+  if (x0) {
+    Expr::Base *band = new Expr::Vacc(new std::string("band"));
+    j = new Expr::Minus(new Expr::Plus(j, band), x0);
+    ext = new Expr::Plus(new Expr::Times(new Expr::Const(2), band),
+                         new Expr::Const(1));
+  }
+
   access = new Expr::Plus(access, new Expr::Times(dim,
         new Expr::Plus(i, new Expr::Times(j, new Expr::Const(left)))));
 
-  Expr::Base *d = new Expr::Times(new Expr::Const(left),
-      new Expr::Plus(n, new Expr::Const(1)));
+  Expr::Base *d = new Expr::Times(new Expr::Const(left), ext);
   dim = new Expr::Times(dim, d);
 
   offset(++track, ++first, end, dim, access);
@@ -232,12 +264,25 @@ void Tablegen::offset_right_lin(titr track, itr first, const itr &end,
   code.push_back(real_jv);
   Expr::Vacc *real_j = new Expr::Vacc(*real_jv);
 
-  access = new Expr::Plus(access, new Expr::Times(dim,
-        new Expr::Plus(i,
-          new Expr::Times(real_j, new Expr::Plus(n, new Expr::Const(1))))));
+  Expr::Base *ext = new Expr::Plus(n, new Expr::Const(1));
+  Expr::Base *x0 = band_index(*track, table);
+  if (x0) {
+    Expr::Base *band = new Expr::Vacc(new std::string("band"));
+    i = new Expr::Minus(new Expr::Plus(i, band), x0);
+    ext = new Expr::Plus(new Expr::Times(new Expr::Const(2), band),
+                         new Expr::Const(1));
+  }
 
-  Expr::Base *d = new Expr::Times(new Expr::Plus(n, new Expr::Const(1)),
-      new Expr::Const(right));
+  if (rows_ && *track == first_track_) {
+    // the outermost term, thus each row i is one contiguous block
+    access = new Expr::Plus(access, new Expr::Times(dim,
+          new Expr::Plus(real_j, new Expr::Times(i, new Expr::Const(right)))));
+  } else {
+    access = new Expr::Plus(access, new Expr::Times(dim,
+          new Expr::Plus(i, new Expr::Times(real_j, ext))));
+  }
+
+  Expr::Base *d = new Expr::Times(ext, new Expr::Const(right));
   dim = new Expr::Times(dim, d);
 
   offset(++track, ++first, end, dim, access);
@@ -307,6 +352,35 @@ void Tablegen::offset(titr track, itr first, const itr &end,
 }
 
 
+static size_t ys_cells(const Yield::Size &ys) {
+  return ys.high().konst() - ys.low().konst() + 1;
+}
+
+size_t Tablegen::cells(const std::vector<Table> &tables, size_t n) {
+  size_t r = 1;
+  for (itr i = tables.begin(); i != tables.end(); ++i) {
+    switch (i->type()) {
+      case Table::CONSTANT :
+        r *= ys_cells(i->left_rest()) * ys_cells(i->right_rest());
+        break;
+      case Table::LINEAR :
+        if (i->sticky() == Table::LEFT)
+          r *= ys_cells(i->left_rest()) * (n + 1);
+        else
+          r *= (n + 1) * ys_cells(i->right_rest());
+        break;
+      case Table::QUADRATIC :
+        r *= n * (n + 1) / 2 + n + 1;
+        break;
+      default :
+        assert(0);
+        std::abort();
+    }
+  }
+  return r;
+}
+
+
 struct ParaCmp {
   bool operator()(const Statement::Var_Decl *a,
                   const Statement::Var_Decl *b) const {
@@ -320,6 +394,8 @@ void Tablegen::offset(size_t track_pos, itr f, const itr &e) {
   paras.clear();
   ns.clear();
   size = 0;
+  band_first_ = band_ && e - f > 1 ? &*f : 0;
+  first_track_ = track_pos;
 
   std::vector<size_t> tracks;
   for (size_t i = track_pos; i < track_pos + size_t(e-f); ++i)
@@ -358,6 +434,18 @@ Statement::Table_Decl *Tablegen::create(Symbol::NT &nt,
 
   std::list<Expr::Base*> ors;
   nt.gen_ys_guards(ors);
+  if (band_ && nt.tracks() > 1) {
+    std::vector<Expr::Base*> left, right;
+    for (size_t t = nt.track_pos(); t < nt.track_pos() + nt.tracks(); ++t) {
+      std::ostringstream si, sj;
+      si << "t_" << t << "_i";
+      sj << "t_" << t << "_j";
+      left.push_back(new Expr::Vacc(new std::string(si.str())));
+      right.push_back(new Expr::Vacc(new std::string(sj.str())));
+    }
+    nt.gen_band_guards(ors, left, right,
+                       new Expr::Vacc(new std::string("band")));
+  }
   if (!ors.empty())
     cond  = Expr::seq_to_tree<Expr::Base, Expr::Or>
       (ors.begin(), ors.end());
@@ -486,13 +574,42 @@ Fn_Def *Tablegen::gen_tab() {
     Statement::Increase *inc_tab_c = new Statement::Increase(
                                      new std::string("tabulated_vals_counter"));
     c.push_back(inc_tab_c);
+
+    if (cyk_) {
+      // remember the block of this cell for the next delta archive
+      Statement::Fn_Call *mark = new Statement::Fn_Call("dirty.mark");
+      mark->add_arg(off);
+      c.push_back(mark);
+    }
   }
 
+  // counts computed cells with -DTABLE_PROFILE, see rtlib/table_profile.hh
+  c.push_back(new Statement::Fn_Call("TABLE_PROFILE_SET"));
+
   Statement::Var_Assign *x = new Statement::Var_Assign(
       new Var_Acc::Array(new Var_Acc::Plain(new std::string("array")), off),
       new Expr::Vacc(new std::string("e")));
   c.push_back(x);
 
+  if (transposed_) {
+    // cell (i, j) at row i of the upper triangle, whose rows have
+    // n + 1, n, ..., 1 cells
+    std::ostringstream si, sj, sn;
+    si << "t_" << first_track_ << "_i";
+    sj << "t_" << first_track_ << "_j";
+    sn << "t_" << first_track_ << "_n";
+    Expr::Vacc *i = new Expr::Vacc(new std::string(si.str()));
+    Expr::Vacc *j = new Expr::Vacc(new std::string(sj.str()));
+    Expr::Vacc *n = new Expr::Vacc(new std::string(sn.str()));
+    Expr::Base *row = new Expr::Div(new Expr::Times(i,
+      new Expr::Plus(new Expr::Minus(new Expr::Times(new Expr::Const(2), n),
+        i), new Expr::Const(1))), new Expr::Const(2));
+    c.push_back(new Statement::Var_Assign(
+      new Var_Acc::Array(new Var_Acc::Plain(new std::string("transposed")),
+        new Expr::Plus(row, j)),
+      new Expr::Vacc(new std::string("e"))));
+  }
+
   if (!cyk_) {
     Statement::Var_Assign *y = new Statement::Var_Assign(
         new Var_Acc::Array(
@@ -506,7 +623,11 @@ Fn_Def *Tablegen::gen_tab() {
 }
 
 Fn_Def *Tablegen::gen_get_tab() {
-  Fn_Def *f = new Fn_Def(new Type::Referencable(dtype), new std::string("get"));
+  Type::Base *t = dtype;
+  if (!soa_) {
+    t = new Type::Referencable(dtype);
+  }
+  Fn_Def *f = new Fn_Def(t, new std::string("get"));
   f->add_paras(paras);
 
   std::list<Statement::Base*> c;
@@ -530,6 +651,8 @@ Fn_Def *Tablegen::gen_get_tab() {
   a->add_arg(new Expr::Less(off, new Expr::Fn_Call(new std::string("size"))));
   c.push_back(a);
 
+  c.push_back(new Statement::Fn_Call("TABLE_PROFILE_GET"));
+
   Statement::Return *ret = new Statement::Return(new Expr::Vacc(
         new Var_Acc::Array(new Var_Acc::Plain(new std::string("array")), off)));
   c.push_back(ret);
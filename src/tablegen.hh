@@ -68,6 +68,21 @@ class Tablegen {
     bool cyk_;
     bool window_mode_;
     bool checkpoint_;
+    bool soa_;
+    bool band_;
+    // with band_, the table of the first track of a multi-track NT, to
+    // whose free index the linear tables of the other tracks are banded
+    const Table *band_first_;
+    // the first track of the NT
+    size_t first_track_;
+    // gapc --linear-space, the cells of a row, i.e. of one free index of
+    // the first track, are stored contiguously, see rtlib/row_table.hh
+    bool rows_;
+    // a quadratic table, whose cells are also stored row-major in
+    // transposed, see Statement::Table_Decl::row_access
+    bool transposed_;
+
+    Expr::Base *band_index(size_t track, const Table &table) const;
 
     void head(Expr::Base *&i, Expr::Base *&j, Expr::Base *&n,
       const Table &table, size_t track);
@@ -92,9 +107,20 @@ class Tablegen {
     Tablegen();
 
     void set_window_mode(bool b) { window_mode_ = b; }
+    // cells are read by value from a Table::SoA
+    void set_soa(bool b) { soa_ = b; }
+    // gapc --band, see AST::banded
+    void set_band(bool b) { band_ = b; }
+    // gapc --linear-space, see AST::linear_space
+    void set_rows(bool b) { rows_ = b; }
+    void set_transposed(bool b) { transposed_ = b; }
 
     void offset(size_t track_pos, itr first, const itr &end);
 
+    // number of cells of a table with these dimensions for inputs of
+    // length n, i.e. size() with t_x_n = n
+    static size_t cells(const std::vector<Table> &tables, size_t n);
+
     Statement::Table_Decl *create(Symbol::NT &nt,
       std::string *name, bool cyk, bool checkpoint);
 };
@@ -0,0 +1,118 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+// Round trip of a checkpoint table archive through the boost binary
+// archive, uncompressed and with chunked compression by several threads.
+// The tables mimic the ones of the bundled RNA folding grammars: a
+// triangular table of int energies, which are mostly the empty value
+// (INT_MAX) or small numbers, and a table of double partition function
+// values.
+//
+// usage: compressed_archive [n] [threads]
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../rtlib/compressed_archive.hh"
+
+static double now() {
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename T>
+static void run(const char *name, const std::vector<T> &array,
+                unsigned threads) {
+  double a = now();
+  std::ostringstream o(std::ios::binary);
+  {
+    gapc::Compressed_Ostream zout(o, threads);
+    {
+      boost::archive::binary_oarchive out(zout);
+      out << array;
+    }
+    zout.finish();
+  }
+  std::string data = o.str();
+  double b = now();
+  std::vector<T> back;
+  {
+    std::istringstream i(data, std::ios::binary);
+    gapc::Compressed_Istream zin(i, threads);
+    boost::archive::binary_iarchive in(zin);
+    in >> back;
+  }
+  double c = now();
+  if (back != array) {
+    std::cerr << "round trip mismatch\n";
+    std::exit(1);
+  }
+  std::cout << std::setw(8) << name << std::setw(9) << threads
+    << std::setw(12) << data.size() / 1024 / 1024
+    << std::setw(8) << std::fixed << std::setprecision(1)
+    << static_cast<double>(array.size() * sizeof(T)) / data.size()
+    << std::setw(10) << std::setprecision(3) << b - a
+    << std::setw(10) << c - b << "\n";
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::atoi(argv[1]) : 4000;
+  unsigned threads = argc > 2 ? std::atoi(argv[2]) : 4;
+  size_t cells = (n + 1) * (n + 2) / 2;
+
+  std::mt19937 gen(42);
+  std::vector<int> energies(cells, INT_MAX);
+  std::vector<double> pfunc(cells);
+  for (size_t j = 0; j <= n; ++j) {
+    for (size_t i = 0; i <= j; ++i) {
+      size_t k = j * (j + 1) / 2 + i;
+      if (j - i > 4 && gen() % 3 == 0) {
+        energies[k] = -static_cast<int>(gen() % 40) * 10 -
+          static_cast<int>(j - i);
+      }
+      pfunc[k] = std::exp(0.01 * (j - i)) * (1 + (gen() % 16) / 64.0);
+    }
+  }
+
+  std::cout << "n = " << n << ", " << cells << " cells\n\n"
+    << "   table  threads   size MiB   ratio   write s    read s\n";
+  run("energy", energies, 0);
+  run("energy", energies, 1);
+  run("energy", energies, threads);
+  run("pfunc", pfunc, 0);
+  run("pfunc", pfunc, 1);
+  run("pfunc", pfunc, threads);
+  return 0;
+}
@@ -0,0 +1,103 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+// Compares the std::vector table storage of generated code with
+// Table::SoA for pair typed answers, like the ones of a lexicographic
+// product mfe * pf, in a recurrence that splits each subword and only
+// looks at the second component on ties of the first one.
+//
+// usage: soa_table [n]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "../../rtlib/soa_table.hh"
+
+typedef std::pair<int, double> cell_t;
+
+static size_t offset(size_t i, size_t j) {
+  return j * (j + 1) / 2 + i;
+}
+
+// same layout as the generated table classes, the get() functions of
+// which return a reference or a value
+struct AoS {
+  std::vector<cell_t> array;
+  explicit AoS(size_t n) : array(n) {}
+  void set(size_t k, const cell_t &e) { array[k] = e; }
+  cell_t &get(size_t k) { return array[k]; }
+};
+
+struct SoA {
+  Table::SoA<cell_t> array;
+  explicit SoA(size_t n) { array.resize(n); }
+  void set(size_t k, const cell_t &e) { array[k] = e; }
+  cell_t get(size_t k) { return array[k]; }
+};
+
+template <typename T>
+static void run(const char *layout, size_t n) {
+  std::chrono::steady_clock::time_point a = std::chrono::steady_clock::now();
+  T t((n + 1) * (n + 2) / 2);
+  for (size_t i = 0; i < n; ++i) {
+    t.set(offset(i, i + 1), cell_t(static_cast<int>(i % 7) - 3, 1.0));
+  }
+  for (size_t l = 2; l <= n; ++l) {
+    for (size_t i = 0; i + l <= n; ++i) {
+      size_t j = i + l;
+      cell_t best(1 << 30, 0);
+      for (size_t k = i + 1; k < j; ++k) {
+        int s = t.get(offset(i, k)).first + t.get(offset(k, j)).first;
+        if (s < best.first) {
+          best = cell_t(s, t.get(offset(i, k)).second *
+                        t.get(offset(k, j)).second);
+        } else if (s == best.first) {
+          best.second += t.get(offset(i, k)).second *
+            t.get(offset(k, j)).second;
+        }
+      }
+      best.second *= 0.5;
+      t.set(offset(i, j), best);
+    }
+  }
+  double s = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - a).count();
+  cell_t r = t.get(offset(0, n));
+  std::cout << std::setw(8) << layout
+    << std::setw(12) << std::fixed << std::setprecision(3) << s
+    << "   (" << r.first << ", " << std::scientific << r.second << ")\n";
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::atoi(argv[1]) : 1000;
+
+  std::cout << "n = " << n << ", " << (n + 1) * (n + 2) / 2 << " cells\n\n"
+    << "  layout    time s\n";
+  run<AoS>("aos", n);
+  run<SoA>("soa", n);
+  return 0;
+}
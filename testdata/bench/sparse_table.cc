@@ -0,0 +1,131 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+// Compares the dense std::vector table storage of generated code with
+// Table::Sparse for quadratic tables, of which only a diagonal band (like
+// for a non-terminal with a maximal yield size) or a random subset (like
+// for base pair filters) of the cells is computed.
+//
+// usage: sparse_table [n] [band width] [random fill in percent]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../../rtlib/sparse_table.hh"
+
+typedef double cell_t;
+
+static size_t offset(size_t i, size_t j) {
+  return j * (j + 1) / 2 + i;
+}
+
+struct Dense {
+  std::vector<cell_t> array;
+  std::vector<bool> tabulated;
+
+  explicit Dense(size_t n) : array(n), tabulated(n) {}
+
+  bool is_tabulated(size_t k) const { return tabulated[k]; }
+  void set(size_t k, cell_t e) { array[k] = e; tabulated[k] = true; }
+  cell_t &get(size_t k) { return array[k]; }
+  size_t bytes() const {
+    return array.size() * sizeof(cell_t) + tabulated.size() / 8;
+  }
+};
+
+// same layout as the generated table classes with sparse storage
+struct Sparse {
+  Table::Sparse<cell_t> array;
+  std::vector<bool> tabulated;
+
+  explicit Sparse(size_t n) : tabulated(n) { array.resize(n); }
+
+  bool is_tabulated(size_t k) const { return tabulated[k]; }
+  void set(size_t k, cell_t e) { array[k] = e; tabulated[k] = true; }
+  cell_t &get(size_t k) { return array[k]; }
+  size_t bytes() const {
+    return array.bytes() + tabulated.size() / 8;
+  }
+};
+
+// fills the cells, then does 4 lookups per cell, like a recurrence with
+// some split points would do
+template <typename T>
+static void run(const char *layout, const char *pattern, size_t n,
+                const std::vector<std::pair<size_t, size_t> > &cells) {
+  std::chrono::steady_clock::time_point a = std::chrono::steady_clock::now();
+  T t((n + 1) * (n + 2) / 2);
+  double sum = 0;
+  for (size_t r = 0; r < cells.size(); ++r) {
+    size_t k = offset(cells[r].first, cells[r].second);
+    t.set(k, static_cast<cell_t>(r));
+    for (size_t l = 0; l < 4; ++l) {
+      size_t o = offset(cells[(r * 7 + l) % (r + 1)].first,
+                        cells[(r * 7 + l) % (r + 1)].second);
+      if (t.is_tabulated(o)) {
+        sum += t.get(o);
+      }
+    }
+  }
+  double s = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - a).count();
+  std::cout << std::setw(8) << layout << std::setw(10) << pattern
+    << std::setw(12) << cells.size()
+    << std::setw(14) << t.bytes() / 1024
+    << std::setw(12) << std::fixed << std::setprecision(3) << s
+    << "   (" << sum << ")\n";
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::atoi(argv[1]) : 5000;
+  size_t w = argc > 2 ? std::atoi(argv[2]) : 30;
+  double p = (argc > 3 ? std::atof(argv[3]) : 3) / 100.0;
+
+  std::vector<std::pair<size_t, size_t> > band, random;
+  for (size_t j = 0; j <= n; ++j) {
+    for (size_t i = j > w ? j - w : 0; i <= j; ++i) {
+      band.push_back(std::make_pair(i, j));
+    }
+  }
+  std::mt19937 gen(42);
+  std::bernoulli_distribution coin(p);
+  for (size_t j = 0; j <= n; ++j) {
+    for (size_t i = 0; i <= j; ++i) {
+      if (coin(gen)) {
+        random.push_back(std::make_pair(i, j));
+      }
+    }
+  }
+
+  std::cout << "n = " << n << ", " << (n + 1) * (n + 2) / 2 << " cells\n\n"
+    << "  layout   pattern    computed     memory KiB    time s\n";
+  run<Dense>("dense", "band", n, band);
+  run<Sparse>("sparse", "band", n, band);
+  run<Dense>("dense", "random", n, random);
+  run<Sparse>("sparse", "random", n, random);
+  return 0;
+}
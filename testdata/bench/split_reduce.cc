@@ -0,0 +1,132 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+// Compares the split loop of generated CYK code, which reads both
+// operands of every candidate by get() and checks them for emptiness,
+// with the fused max-plus reduction of rtlib/split_reduce.hh over a row
+// of a transposed copy and a column of the table, in a Nussinov-like
+// recurrence with an int answer type.
+//
+// usage: split_reduce [n]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../../rtlib/empty.hh"
+#include "../../rtlib/split_reduce.hh"
+
+static size_t offset(size_t i, size_t j) {
+  return j * (j + 1) / 2 + i;
+}
+
+static size_t row_offset(size_t n, size_t i) {
+  return i * (2 * n - i + 1) / 2;
+}
+
+// bp(k, j) is non-empty, if the bases k and j - 1 pair
+static bool pairs(size_t k, size_t j) {
+  return (k * 7 + j * 3) % 5 == 0;
+}
+
+struct Tables {
+  size_t n;
+  std::vector<int> start, bp, transposed;
+  explicit Tables(size_t n_) : n(n_) {
+    size_t cells = offset(n, n) + 1;
+    int zero;
+    empty(zero);
+    start.assign(cells, zero);
+    bp.assign(cells, zero);
+    transposed.assign(cells, zero);
+  }
+  void set(size_t i, size_t j, int e) {
+    start[offset(i, j)] = e;
+    transposed[row_offset(n, i) + j] = e;
+  }
+};
+
+static int loop(Tables &t, size_t i, size_t j) {
+  int answers;
+  empty(answers);
+  for (size_t k = i; k + 2 <= j; ++k) {
+    int b = t.bp[offset(k, j)];
+    if (isEmpty(b)) {
+      continue;
+    }
+    int a = t.start[offset(i, k)];
+    if (isEmpty(a)) {
+      continue;
+    }
+    int ans = a + b;
+    if (isEmpty(answers) || answers < ans) {
+      answers = ans;
+    }
+  }
+  return answers;
+}
+
+static int fused(Tables &t, size_t i, size_t j) {
+  return split_max_plus(
+    t.transposed.data() + row_offset(t.n, i),
+    t.bp.data() + offset(0, j), i, j - 1);
+}
+
+template <int (*split)(Tables &, size_t, size_t)>
+static void run(const char *name, size_t n) {
+  std::chrono::steady_clock::time_point a = std::chrono::steady_clock::now();
+  Tables t(n);
+  for (size_t j = 0; j <= n; ++j) {
+    for (size_t i = j + 1; i-- > 0;) {
+      if (j - i >= 2 && pairs(i, j)) {
+        int inner = t.start[offset(i + 1, j - 1)];
+        t.bp[offset(i, j)] = isEmpty(inner) ? inner : inner + 1;
+      }
+      int s = i == j ? 0 : t.start[offset(i, j - 1)];
+      if (j - i >= 2) {
+        int r = split(t, i, j);
+        if (is_not_empty(r) && r > s) {
+          s = r;
+        }
+      }
+      t.set(i, j, s);
+    }
+  }
+  double s = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - a).count();
+  std::cout << std::setw(8) << name
+    << std::setw(12) << std::fixed << std::setprecision(3) << s
+    << "   " << t.start[offset(0, n)] << "\n";
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::atoi(argv[1]) : 2000;
+
+  std::cout << "n = " << n << "\n\n"
+    << "   split    time s\n";
+  run<loop>("loop", n);
+  run<fused>("fused", n);
+  return 0;
+}
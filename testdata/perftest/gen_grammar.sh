@@ -0,0 +1,68 @@
+#!/bin/sh
+
+# usage: gen_grammar.sh NTS [SEED]
+#
+# Prints a random gap program with NTS non-terminals, for measuring the
+# scalability of gapc. Every alternative reads at least one character,
+# thus the grammar has no cycles; nt_k always derives nt_(k+1), thus all
+# non-terminals are reachable. The signature has one function per
+# alternative shape and about NTS/4 variants of each.
+
+set -u
+
+NTS=$1
+SEED=${2:-42}
+
+awk -v nts=$NTS -v seed=$SEED 'BEGIN {
+  srand(seed);
+  fns = int(nts / 4) + 1;
+
+  print "signature Sig(alphabet, answer) {";
+  print "  answer nil(void);";
+  for (f = 0; f < fns; ++f) {
+    printf "  answer l%d(alphabet, answer);\n", f;
+    printf "  answer r%d(answer, alphabet);\n", f;
+    printf "  answer s%d(answer, alphabet, answer);\n", f;
+  }
+  print "  choice [answer] h([answer]);";
+  print "}";
+  print "";
+  print "algebra count auto count ;";
+  print "";
+  print "algebra enum auto enum ;";
+  print "";
+  print "grammar rnd uses Sig (axiom = nt0) {";
+  print "";
+  printf "  tabulated {";
+  for (k = 0; k < nts; ++k) {
+    if (rand() < 0.3) {
+      printf "%s nt%d", tabs++ ? "," : "", k;
+    }
+  }
+  if (!tabs)
+    printf " nt0";
+  print " }";
+  print "";
+  for (k = 0; k < nts; ++k) {
+    next_nt = k + 1 < nts ? k + 1 : 0;
+    printf "  nt%d = nil(EMPTY) |\n", k;
+    printf "    l%d(CHAR, nt%d)", int(rand() * fns), next_nt;
+    alts = int(rand() * 4) + 1;
+    for (a = 0; a < alts; ++a) {
+      x = int(rand() * nts);
+      y = int(rand() * nts);
+      t = rand();
+      if (t < 0.4) {
+        printf " |\n    r%d(nt%d, CHAR)", int(rand() * fns), x;
+      } else {
+        printf " |\n    s%d(nt%d, CHAR, nt%d)", int(rand() * fns), x, y;
+      }
+    }
+    print " # h ;";
+    print "";
+  }
+  print "}";
+  print "";
+  print "instance count = rnd ( count ) ;";
+  print "instance enum = rnd ( enum ) ;";
+}'
@@ -0,0 +1,65 @@
+/*
+ * usage: measure RESULT-FILE PROGRAM [ARGS...]
+ *
+ * Runs PROGRAM and writes its wall time in seconds, its peak resident set
+ * size in KiB and its exit status to RESULT-FILE, such that the stdout and
+ * stderr of PROGRAM can be redirected by the caller.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+static double now(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s RESULT-FILE PROGRAM [ARGS...]\n", argv[0]);
+    return 2;
+  }
+  double a = now();
+  pid_t pid = fork();
+  if (pid == -1) {
+    perror("fork");
+    return 2;
+  }
+  if (!pid) {
+    execvp(argv[2], argv + 2);
+    perror(argv[2]);
+    _exit(127);
+  }
+  int status = 0;
+  struct rusage usage;
+  if (wait4(pid, &status, 0, &usage) == -1) {
+    perror("wait4");
+    return 2;
+  }
+  double s = now() - a;
+
+  FILE *out = fopen(argv[1], "w");
+  if (!out) {
+    perror(argv[1]);
+    return 2;
+  }
+  int ret = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+  /* ru_maxrss is in KiB on Linux, but in bytes on macOS */
+#ifdef __APPLE__
+  long rss = usage.ru_maxrss / 1024;
+#else
+  long rss = usage.ru_maxrss;
+#endif
+  fprintf(out, "%.6f %ld %d\n", s, rss, ret);
+  fclose(out);
+  return ret;
+}
@@ -0,0 +1,211 @@
+#!/bin/sh
+
+# Performance regression benchmarks: compiles the programs listed in
+# ./config, runs them on synthetic inputs of increasing length and records
+# wall time, peak RSS and cells/sec as JSON. The results are compared
+# against a stored baseline, which is written instead if UPDATE=1.
+#
+# usage: run.sh [FILTER]
+#
+# environment:
+#   BASELINE  baseline file (default: ./baseline.json)
+#   RESULTS   result file (default: ./temp/results.json)
+#   UPDATE    if 1, store the results as the new baseline
+#   REPEATS   runs per input, the fastest one counts (default: 3)
+#   TIME_TOL  tolerated relative slow down (default: 0.2)
+#   TIME_SLACK  tolerated absolute slow down in seconds (default: 0.05)
+#   RSS_TOL   tolerated relative increase of the peak RSS (default: 0.1)
+
+set -u
+
+DIR_BASE=../../..
+GAPC=$DIR_BASE/gapc
+MAKE=make
+MAKEFLAGS="-I$DIR_BASE/testdata/gapc_filter"
+MEASURE=../measure
+
+TEMP=./temp
+GRAMMAR=$DIR_BASE/testdata/grammar
+DEFAULT_CPPFLAGS_EXTRA=" -I$DIR_BASE/testdata/gapc_filter "
+DEFAULT_LDLIBS_EXTRA=""
+
+BASELINE=${BASELINE:-`pwd`/baseline.json}
+RESULTS=${RESULTS:-`pwd`/temp/results.json}
+UPDATE=${UPDATE:-0}
+REPEATS=${REPEATS:-3}
+TIME_TOL=${TIME_TOL:-0.2}
+TIME_SLACK=${TIME_SLACK:-0.05}
+RSS_TOL=${RSS_TOL:-0.1}
+
+FILTER=.
+if [ $# -ge 1 ]; then
+  FILTER=$1
+fi
+
+err_count=0
+succ_count=0
+
+mkdir -p $TEMP
+cd $TEMP
+
+printf "[\n" > $RESULTS
+first_record=1
+
+# mode NAME GAPC-FLAGS [RUN-FLAGS [CPPFLAGS-EXTRA [LDLIBS-EXTRA]]]
+#   sets the code generation mode of the following bench calls
+mode()
+{
+  MODE=$1
+  GAPC_FLAGS=$2
+  RUN_FLAGS=${3:-}
+  CPPFLAGS_EXTRA="$DEFAULT_CPPFLAGS_EXTRA ${4:-}"
+  LDLIBS_EXTRA="$DEFAULT_LDLIBS_EXTRA ${5:-}"
+}
+
+# gen_input KIND N SEED
+#   prints a synthetic input of length N, the same for equal seeds
+gen_input()
+{
+  awk -v kind=$1 -v n=$2 -v seed=$3 'BEGIN {
+    srand(seed);
+    if (kind == "rna") {
+      for (i = 0; i < n; ++i)
+        printf "%s", substr("acgu", int(rand() * 4) + 1, 1);
+    } else if (kind == "expr") {
+      # digits and operators of an El Mamun bill, n odd
+      for (i = 0; i < n; ++i)
+        if (i % 2)
+          printf "%s", substr("+*", int(rand() * 2) + 1, 1);
+        else
+          printf "%d", int(rand() * 10);
+    } else if (kind == "matrix") {
+      # n matrices with matching dimensions, "rows,cols," each
+      r = int(rand() * 100) + 1;
+      for (i = 0; i < n; ++i) {
+        c = int(rand() * 100) + 1;
+        printf "%d,%d,", r, c;
+        r = c;
+      }
+    } else if (kind == "flow") {
+      for (i = 0; i < n; ++i)
+        printf "%s%.2f", i ? " " : "", rand() < 0.5 ? rand() * 0.2 : \
+          int(rand() * 4) + 1 + (rand() - 0.5) * 0.2;
+    } else if (kind == "align") {
+      # two sequences of n/2 characters, separated by $
+      for (i = 0; i < n; ++i)
+        printf "%s", i == int(n / 2) ? "$" : \
+          substr("acgt", int(rand() * 4) + 1, 1);
+    }
+  }'
+}
+
+# record NAME N SECONDS RSS
+record()
+{
+  cells=`awk -v n=$2 -v s=$3 'BEGIN { printf "%.0f", (s > 0 ? n * (n + 1) / 2 / s : 0) }'`
+  if [ $first_record = 0 ]; then
+    printf ",\n" >> $RESULTS
+  fi
+  first_record=0
+  printf '{"name": "%s", "mode": "%s", "n": %d, "seconds": %s, "peak_rss_kb": %d, "cells_per_sec": %s}' \
+    $1 $MODE $2 $3 $4 $cells >> $RESULTS
+  printf "  %-28s %-10s n=%-6d %10s s %10d KiB %14s cells/s\n" \
+    $1 $MODE $2 $3 $4 $cells
+}
+
+# bench GRAMMAR INSTANCE INPUT-KIND LENGTHS
+#   cells/sec is the number of cells of a quadratic table over the input
+#   divided by the wall time, i.e. comparable between modes of a program
+bench()
+{
+  name=${1%%.*}.$2
+  if [ `echo $name.$MODE | grep -c $FILTER` = 0 ]; then
+    return
+  fi
+  base=${1%%.*}_$2_$MODE
+  if ! $GAPC $GAPC_FLAGS $GRAMMAR/$1 -i $2 -o $base.cc > $base.gapc.log 2>&1 ||
+     ! $MAKE $MAKEFLAGS -f $base.mf CPPFLAGS_EXTRA="$CPPFLAGS_EXTRA" \
+       LDLIBS_EXTRA="$LDLIBS_EXTRA" > $base.make.log 2>&1; then
+    echo "  $name $MODE: build failed, see $TEMP/$base.*.log"
+    err_count=$((err_count+1))
+    return
+  fi
+  for n in $4; do
+    gen_input $3 $n 42 > $base.$n.in
+    best=""
+    rss=0
+    r=0
+    while [ $r -lt $REPEATS ]; do
+      if ! $MEASURE $base.$n.time ./$base $RUN_FLAGS -f $base.$n.in \
+           > $base.$n.out 2> $base.$n.err; then
+        echo "  $name $MODE n=$n: run failed, see $TEMP/$base.$n.err"
+        err_count=$((err_count+1))
+        best=""
+        break
+      fi
+      read s m ret < $base.$n.time
+      best=`awk -v a="$best" -v b=$s 'BEGIN { print (a == "" || b < a) ? b : a }'`
+      if [ $m -gt $rss ]; then
+        rss=$m
+      fi
+      r=$((r+1))
+    done
+    if [ -n "$best" ]; then
+      record $name $n $best $rss
+      succ_count=$((succ_count+1))
+    fi
+  done
+}
+
+. ../config
+
+printf "\n]\n" >> $RESULTS
+
+echo
+if [ $UPDATE = 1 ]; then
+  cp $RESULTS $BASELINE
+  echo "Stored the results as new baseline $BASELINE"
+elif [ ! -e $BASELINE ]; then
+  echo "No baseline $BASELINE, run 'make bench-baseline' to store one"
+else
+  # one record per line, see record()
+  if ! awk -v time_tol=$TIME_TOL -v time_slack=$TIME_SLACK \
+      -v rss_tol=$RSS_TOL '
+    function field(line, key,    s) {
+      if (!match(line, "\"" key "\": [^,}]*"))
+        return "";
+      s = substr(line, RSTART, RLENGTH);
+      sub(/^[^:]*: */, "", s);
+      gsub(/"/, "", s);
+      return s;
+    }
+    /"name"/ {
+      k = field($0, "name") " " field($0, "mode") " " field($0, "n");
+      if (FILENAME == ARGV[1]) {
+        t[k] = field($0, "seconds");
+        m[k] = field($0, "peak_rss_kb");
+        next;
+      }
+      if (!(k in t)) {
+        next;
+      }
+      s = field($0, "seconds");
+      r = field($0, "peak_rss_kb");
+      if (s > t[k] * (1 + time_tol) + time_slack) {
+        printf "  REGRESSION %s: %s s, baseline %s s\n", k, s, t[k];
+        bad = 1;
+      }
+      if (r > m[k] * (1 + rss_tol)) {
+        printf "  REGRESSION %s: %s KiB, baseline %s KiB\n", k, r, m[k];
+        bad = 1;
+      }
+    }
+    END { exit bad }' $BASELINE $RESULTS; then
+    err_count=$((err_count+1))
+  else
+    echo "No regressions against baseline $BASELINE"
+  fi
+fi
+
+echo "Results: $RESULTS"
+. ../../stats.sh
@@ -0,0 +1,80 @@
+#!/bin/sh
+
+# Scalability of gapc: compiles random grammars of increasing size (see
+# gen_grammar.sh) with --time-passes --memory-passes and records the total
+# wall time, the peak RSS and the wall time of each compiler pass as JSON.
+#
+# usage: stress.sh [SIZES]
+#
+# environment:
+#   RESULTS   result file (default: ./temp/stress.json)
+#   SEED      seed of the grammar generator (default: 42)
+
+set -u
+
+DIR_BASE=../../..
+GAPC=$DIR_BASE/gapc
+MEASURE=../measure
+
+TEMP=./temp
+
+SIZES=${1:-"25 50 100 200 400 800"}
+RESULTS=${RESULTS:-`pwd`/temp/stress.json}
+SEED=${SEED:-42}
+
+err_count=0
+succ_count=0
+
+mkdir -p $TEMP
+cd $TEMP
+
+printf "[\n" > $RESULTS
+first_record=1
+
+# stress MODE GAPC-FLAGS
+stress()
+{
+  for n in $SIZES; do
+    base=stress_${n}_$1
+    sh ../gen_grammar.sh $n $SEED > $base.gap
+    if ! $MEASURE $base.time $GAPC $2 --time-passes --memory-passes \
+         $base.gap -i count -o $base.cc > $base.out 2> $base.passes; then
+      echo "  $1 nts=$n: gapc failed, see $TEMP/$base.passes"
+      err_count=$((err_count+1))
+      continue
+    fi
+    read s m ret < $base.time
+    if [ $first_record = 0 ]; then
+      printf ",\n" >> $RESULTS
+    fi
+    first_record=0
+    # the time report lists "wall cpu wall% pass", indented by depth
+    awk -v mode=$1 -v n=$n -v s=$s -v m=$m '
+      /pass execution times/ { t = 1; next; }
+      /pass memory usage/ { t = 0; next; }
+      t && $1 ~ /^[0-9]/ {
+        line = $0;
+        sub(/^ *[^ ]+ +[^ ]+ +[^ ]+   /, "", line);
+        match(line, /^ */);
+        name = substr(line, RLENGTH + 1);
+        passes = passes sprintf("%s\n  {\"pass\": \"%s\", \"depth\": %d, \"seconds\": %s}",
+          passes == "" ? "" : ",", name, RLENGTH / 2, $1);
+      }
+      END {
+        printf "{\"nts\": %d, \"mode\": \"%s\", \"seconds\": %s, \"peak_rss_kb\": %d, \"passes\": [%s]}",
+          n, mode, s, m, passes;
+      }' $base.passes >> $RESULTS
+    printf "  %-14s nts=%-6d %10s s %10d KiB\n" $1 $n $s $m
+    succ_count=$((succ_count+1))
+  done
+}
+
+stress conf ""
+stress table-design "-t"
+stress cyk "-t --cyk"
+
+printf "\n]\n" >> $RESULTS
+
+echo
+echo "Results: $RESULTS"
+. ../../stats.sh
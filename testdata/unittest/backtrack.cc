@@ -0,0 +1,160 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE backtrack
+#include <boost/test/unit_test.hpp>
+#include "macros.hh"
+
+#include <vector>
+
+#include "../../rtlib/backtrack.hh"
+
+typedef Backtrace_Score<int, int, unsigned> Score_BT;
+
+struct Candidate : public Score_BT {
+  int value;
+
+  Candidate(int score, int v) : value(v) {
+    this->setScore(score);
+  }
+
+  intrusive_ptr<Eval_List<int> > eval() {
+    intrusive_ptr<Eval_List<int> > l = new Eval_List<int>();
+    l->push_back(value);
+    return l;
+  }
+};
+
+struct Klass {
+  size_t calls;
+  Klass() : calls(0) {}
+};
+
+struct Back : public Backtrace_NT_Back_Base<int, Klass, int, unsigned> {
+  explicit Back(Klass *k)
+    : Backtrace_NT_Back_Base<int, Klass, int, unsigned>(k) {}
+
+  void backtrack() {
+    this->klass->calls++;
+    this->scores = new Backtrace_List<int, unsigned>();
+    int cands[5][2] = { {3, 30}, {1, 10}, {3, 31}, {2, 20}, {1, 11} };
+    for (size_t i = 0; i < 5; ++i)
+      this->scores->push_back(new Candidate(cands[i][0], cands[i][1]));
+  }
+};
+
+static std::vector<int> values(intrusive_ptr<Backtrace<int, unsigned> > bt) {
+  std::vector<int> r;
+  intrusive_ptr<Eval_List<int> > l = bt->eval();
+  for (Eval_List<int>::iterator i = l->begin(); i != l->end(); ++i)
+    r.push_back(*i);
+  return r;
+}
+
+BOOST_AUTO_TEST_CASE(back_classes) {
+  Klass klass;
+  // as in the generated Front classes, via the base
+  intrusive_ptr<Backtrace_NT_Back_Base<int, Klass, int, unsigned> > back =
+    new Back(&klass);
+
+  std::vector<int> v = values(back->backtrack(3));
+  CHECK_EQ(v.size(), 2u);
+  CHECK_EQ(v[0], 30);
+  CHECK_EQ(v[1], 31);
+
+  v = values(back->backtrack(1));
+  CHECK_EQ(v.size(), 2u);
+  CHECK_EQ(v[0], 10);
+  CHECK_EQ(v[1], 11);
+
+  // repeated requests of a class yield the same candidates
+  v = values(back->backtrack(3));
+  CHECK_EQ(v.size(), 2u);
+  CHECK_EQ(v[0], 30);
+
+  v = values(back->backtrack(2));
+  CHECK_EQ(v.size(), 1u);
+  CHECK_EQ(v[0], 20);
+
+  CHECK(values(back->backtrack(42)).empty());
+
+  // the candidates of the cell are computed only once
+  CHECK_EQ(klass.calls, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(back_frontier) {
+  Klass klass;
+  intrusive_ptr<Back> b = new Back(&klass);
+  // a k-scoring list of the forward pass, best score first
+  expect_score(b, 3);
+  expect_score(b, 2);
+  intrusive_ptr<Backtrace_NT_Back_Base<int, Klass, int, unsigned> > back = b;
+
+  std::vector<int> v = values(back->backtrack(3));
+  CHECK_EQ(v.size(), 2u);
+  CHECK_EQ(v[0], 30);
+  CHECK_EQ(v[1], 31);
+
+  v = values(back->backtrack(2));
+  CHECK_EQ(v.size(), 1u);
+  CHECK_EQ(v[0], 20);
+
+  v = values(back->backtrack(3));
+  CHECK_EQ(v.size(), 2u);
+  CHECK_EQ(v[1], 31);
+
+  // not announced
+  CHECK(values(back->backtrack(1)).empty());
+  CHECK_EQ(klass.calls, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(back_single_and_classes) {
+  typedef Backtrace_NT_Back_Base<int, Klass, int, unsigned> Base;
+  Klass klass;
+  intrusive_ptr<Back> b = new Back(&klass);
+  expect_score(b, 1);
+  intrusive_ptr<Base> back = b;
+  std::vector<int> v = values(back->backtrack(1));
+  CHECK_EQ(v.size(), 2u);
+  CHECK_EQ(v[0], 10);
+  CHECK_EQ(v[1], 11);
+  CHECK(values(back->backtrack(3)).empty());
+
+  // unordered score classes, as of classifying answers
+  b = new Back(&klass);
+  expect_score(b, 2);
+  expect_score(b, 3);
+  expect_score(b, 1);
+  back = b;
+  v = values(back->backtrack(1));
+  CHECK_EQ(v.size(), 2u);
+  CHECK_EQ(v[1], 11);
+  v = values(back->backtrack(2));
+  CHECK_EQ(v.size(), 1u);
+  v = values(back->backtrack(3));
+  CHECK_EQ(v.size(), 2u);
+  CHECK_EQ(v[0], 30);
+  CHECK_EQ(klass.calls, 2u);
+}
@@ -0,0 +1,72 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE checkpoint_gate
+#include <boost/test/unit_test.hpp>
+#include "macros.hh"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../../rtlib/checkpoint_gate.hh"
+
+// the archiver never observes a cell in progress
+BOOST_AUTO_TEST_CASE(gate_exclusive) {
+  gapc::Checkpoint_Gate gate;
+  std::atomic<int> in_cell(0);
+  std::atomic<bool> done(false);
+  std::atomic<size_t> cells(0);
+  bool violated = false;
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < 4; ++t) {
+    workers.push_back(std::thread([&] {
+      for (int i = 0; i < 200000; ++i) {
+        std::shared_lock<gapc::Checkpoint_Gate> lock(gate);
+        in_cell.fetch_add(1);
+        in_cell.fetch_sub(1);
+        cells.fetch_add(1, std::memory_order_relaxed);
+      }
+    }));
+  }
+  std::thread archiver([&] {
+    size_t archives = 0;
+    while (!done.load() || archives < 10) {
+      std::lock_guard<gapc::Checkpoint_Gate> lock(gate);
+      if (in_cell.load() != 0) {
+        violated = true;
+      }
+      ++archives;
+    }
+  });
+  for (size_t t = 0; t < workers.size(); ++t) {
+    workers[t].join();
+  }
+  done.store(true);
+  archiver.join();
+  CHECK(!violated);
+  CHECK_EQ(cells.load(), 800000u);
+}
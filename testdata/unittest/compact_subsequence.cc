@@ -0,0 +1,80 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE compact_subsequence
+#include <boost/test/unit_test.hpp>
+#include "macros.hh"
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// as in the generated code of one track programs
+#define COMPACT_SUBSEQUENCE
+#include "../../rtlib/empty.hh"
+#include "../../rtlib/subsequence.hh"
+
+BOOST_AUTO_TEST_CASE(compact_layout) {
+  CHECK_EQ(sizeof(Subsequence), 2 * sizeof(unsigned));
+  CHECK(std::is_trivially_copyable<Subsequence>::value);
+  typedef std::pair<int, Subsequence> cell;
+  CHECK_EQ(sizeof(cell), 3 * sizeof(unsigned));
+}
+
+BOOST_AUTO_TEST_CASE(compact_access) {
+  Sequence s;
+  const char *t = "acgutt";
+  s.copy(t, std::strlen(t));
+  Subsequence::seq = &s;
+
+  const Subsequence sub(s, 1, 4);
+  CHECK(!isEmpty(sub));
+  CHECK_EQ(sub.size(), 3u);
+  CHECK_EQ(sub.front(), 'c');
+  CHECK_EQ(sub[3], 'u');
+  CHECK_EQ(seq_size(sub), 6u);
+  CHECK_EQ(std::string(sub.begin(), sub.end()), "cgu");
+
+  // tables keep cells as raw memory, e.g. when restored from a checkpoint
+  std::vector<Subsequence> table(3);
+  table[1] = sub;
+  std::vector<Subsequence> copy(3);
+  std::memcpy(copy.data(), table.data(), 3 * sizeof(Subsequence));
+  CHECK_EQ(copy[1][1], 'c');
+  CHECK(isEmpty(copy[0]));
+}
+
+BOOST_AUTO_TEST_CASE(compact_empty) {
+  Subsequence sub;
+  CHECK(isEmpty(sub));
+  CHECK_EQ(sub.size(), 0u);
+  Sequence s;
+  Subsequence::seq = &s;
+  Subsequence e(s, 0, 0);
+  CHECK(!isEmpty(e));
+  empty(e);
+  CHECK(isEmpty(e));
+}
@@ -0,0 +1,136 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE compressed_archive
+#include <boost/test/unit_test.hpp>
+#include "macros.hh"
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../rtlib/compressed_archive.hh"
+#include "../../rtlib/delta_archive.hh"
+
+static const char path[] = "compressed_archive_test.bin";
+
+// several frames per batch and a partial last batch
+static std::vector<double> table() {
+  std::vector<double> array(3 * gapc::zchunk::CHUNK / sizeof(double) + 1001);
+  for (size_t i = 0; i < array.size(); ++i) {
+    array[i] = static_cast<double>(i % 977) / 10.0;
+  }
+  return array;
+}
+
+static std::string write(const std::vector<double> &array, unsigned threads) {
+  std::ostringstream o(std::ios::binary);
+  gapc::Compressed_Ostream zout(o, threads);
+  {
+    boost::archive::binary_oarchive out(zout);
+    out << array;
+  }
+  zout.finish();
+  CHECK(zout.good());
+  return o.str();
+}
+
+static std::vector<double> read(const std::string &data, unsigned threads) {
+  std::istringstream i(data, std::ios::binary);
+  gapc::Compressed_Istream zin(i, threads);
+  boost::archive::binary_iarchive in(zin);
+  std::vector<double> array;
+  in >> array;
+  return array;
+}
+
+BOOST_AUTO_TEST_CASE(compressed_round_trip) {
+  std::vector<double> array = table();
+  std::string z = write(array, 2);
+  CHECK(z.size() < array.size() * sizeof(double) / 4);
+  CHECK(read(z, 3) == array);
+  CHECK(read(z, 1) == array);
+}
+
+BOOST_AUTO_TEST_CASE(uncompressed_pass_through) {
+  std::vector<double> array = table();
+  std::string raw = write(array, 0);
+  CHECK(raw.size() > array.size() * sizeof(double));
+  CHECK(read(raw, 2) == array);
+}
+
+BOOST_AUTO_TEST_CASE(compressed_truncated) {
+  std::string z = write(table(), 2);
+  z.resize(z.size() - 100);
+  bool thrown = false;
+  try {
+    read(z, 2);
+  } catch (const std::exception &e) {
+    thrown = true;
+  }
+  CHECK(thrown);
+}
+
+BOOST_AUTO_TEST_CASE(delta_compressed) {
+  std::vector<double> array = table();
+  size_t n = array.size();
+  gapc::Dirty_Blocks dirty;
+  dirty.resize(n);
+  std::remove(path);
+
+  CHECK(gapc::append_delta(path, array, dirty, 1, 2));
+  array[n - 1] = -1;
+  dirty.mark(n - 1);
+  CHECK(gapc::append_delta(path, array, dirty, 2, 2));
+
+  std::vector<double> restored;
+  size_t counter = 0;
+  CHECK(gapc::load_delta(path, restored, counter, 3));
+  CHECK_EQ(counter, 2u);
+  CHECK(restored == array);
+
+  // a torn frame of the last record is not restored; cut into the
+  // frame before the end frame and the commit record
+  std::ifstream in(path, std::ios::binary);
+  std::string data((std::istreambuf_iterator<char>(in)),
+                   std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(data.data(), data.size() - 40);
+  out.close();
+  restored.clear();
+  counter = 0;
+  CHECK(gapc::load_delta(path, restored, counter, 2));
+  CHECK_EQ(counter, 1u);
+  CHECK_EQ(restored[n - 1], static_cast<double>((n - 1) % 977) / 10.0);
+  CHECK_EQ(restored[5], array[5]);
+  std::remove(path);
+}
@@ -0,0 +1,134 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE delta_archive
+#include <boost/test/unit_test.hpp>
+#include "macros.hh"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../../rtlib/delta_archive.hh"
+
+static const char path[] = "delta_archive_test.bin";
+
+BOOST_AUTO_TEST_CASE(delta_round_trip) {
+  size_t n = 3 * (1 << gapc::Dirty_Blocks::BITS) + 17;
+  std::vector<double> array(n);
+  gapc::Dirty_Blocks dirty;
+  dirty.resize(n);
+  std::remove(path);
+
+  // first archive compacts, i.e. writes the complete table
+  array[1] = 1.5;
+  dirty.mark(1);
+  CHECK(gapc::append_delta(path, array, dirty, 1));
+  CHECK(!dirty.is_dirty(0));
+
+  array[n - 1] = 2.5;
+  dirty.mark(n - 1);
+  CHECK(gapc::append_delta(path, array, dirty, 2));
+  array[4] = 3.5;
+  dirty.mark(4);
+  CHECK(gapc::append_delta(path, array, dirty, 3));
+
+  std::vector<double> restored;
+  size_t counter = 0;
+  CHECK(gapc::load_delta(path, restored, counter));
+  CHECK_EQ(restored.size(), n);
+  CHECK_EQ(counter, 3u);
+  CHECK(restored == array);
+  std::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(delta_truncated) {
+  size_t n = 100;
+  std::vector<int> array(n, 7);
+  gapc::Dirty_Blocks dirty;
+  dirty.resize(n);
+  std::remove(path);
+  CHECK(gapc::compact_delta(path, array, 0));
+  for (size_t i = 0; i < n; ++i) {
+    array[i] = 8;
+    dirty.mark(i);
+  }
+  CHECK(gapc::append_delta(path, array, dirty, n));
+
+  // simulate a crash during the last append
+  std::ifstream in(path, std::ios::binary);
+  std::string data((std::istreambuf_iterator<char>(in)),
+                   std::istreambuf_iterator<char>());
+  in.close();
+  size_t cut = 3 * sizeof(int) + 2 * sizeof(uint64_t) + 1;
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(data.data(), data.size() - cut);
+  out.close();
+
+  std::vector<int> restored;
+  size_t counter = 0;
+  CHECK(gapc::load_delta(path, restored, counter));
+  CHECK_EQ(counter, 0u);
+  CHECK_EQ(restored[0], 8);
+  CHECK_EQ(restored[n - 5], 8);
+  // the partially written cell keeps its old value
+  CHECK_EQ(restored[n - 4], 7);
+  CHECK_EQ(restored[n - 1], 7);
+  std::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(delta_unsupported) {
+  std::vector<std::string> array(3);
+  gapc::Dirty_Blocks dirty;
+  dirty.resize(3);
+  CHECK(!gapc::append_delta(path, array, dirty, 0));
+  std::ofstream out(path);
+  out << "boost archive";
+  out.close();
+  std::vector<double> d;
+  size_t counter = 0;
+  CHECK(!gapc::load_delta(path, d, counter));
+  std::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(dirty_take_merge) {
+  gapc::Dirty_Blocks dirty;
+  size_t block = size_t(1) << gapc::Dirty_Blocks::BITS;
+  dirty.resize(3 * block);
+  dirty.mark(1);
+  dirty.mark(2 * block);
+  std::vector<unsigned char> taken = dirty.take();
+  CHECK_EQ(taken.size(), dirty.blocks());
+  CHECK(taken[0] && !taken[1] && taken[2]);
+  CHECK(!dirty.is_dirty(0));
+  CHECK(!dirty.is_dirty(2));
+
+  dirty.mark(block);
+  dirty.merge(taken);
+  CHECK(dirty.is_dirty(0));
+  CHECK(dirty.is_dirty(1));
+  CHECK(dirty.is_dirty(2));
+}
@@ -0,0 +1,104 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE ext_double
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <vector>
+#include "macros.hh"
+
+#include "../../rtlib/ext_double.hh"
+#include "../../rtlib/algebra.hh"
+
+BOOST_AUTO_TEST_CASE(arithmetic) {
+  ExtDouble a(3.0), b(0.5);
+  CHECK_EQ((a + b).to_double(), 3.5);
+  CHECK_EQ((a - b).to_double(), 2.5);
+  CHECK_EQ((a * b).to_double(), 1.5);
+  CHECK_EQ((a / b).to_double(), 6.0);
+  CHECK_EQ((b - a).to_double(), -2.5);
+  CHECK_EQ((a - a).to_double(), 0.0);
+  CHECK(b < a);
+  CHECK(-a < b);
+  CHECK(-a < -b);
+  CHECK(a == ExtDouble(3.0));
+}
+
+BOOST_AUTO_TEST_CASE(range) {
+  // 1e-300^20 underflows a double
+  ExtDouble p(1.0);
+  for (int i = 0; i < 20; ++i)
+    p *= 1e-300;
+  CHECK(p > ExtDouble(0.0));
+  CHECK_EQ(p.to_double(), 0.0);
+  BOOST_CHECK_CLOSE(log(p), 20 * std::log(1e-300), 1e-9);
+  CHECK(p < ExtDouble(1e-300));
+
+  ExtDouble q(1.0);
+  for (int i = 0; i < 20; ++i)
+    q *= 1e300;
+  CHECK(q > ExtDouble(1e300));
+  BOOST_CHECK_CLOSE((p * q).to_double(), 1.0, 1e-9);
+
+  // small summands vanish, but do not destroy the big one
+  CHECK_EQ((q + p).exponent(), q.exponent());
+
+  BOOST_CHECK_CLOSE(log(ext_exp(-20000.0)), -20000.0, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(empty_sum) {
+  ExtDouble x;
+  empty(x);
+  CHECK(isEmpty(x));
+  CHECK(!isEmpty(ExtDouble(2.0)));
+
+  std::vector<ExtDouble> v;
+  v.push_back(ext_exp(-1000.0));
+  v.push_back(ext_exp(-1000.0));
+  ExtDouble s = sum(v.begin(), v.end());
+  BOOST_CHECK_CLOSE(log(s), -1000.0 + std::log(2.0), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(output) {
+  std::ostringstream o;
+  o << ext_exp(-20000.0 * std::log(10.0));
+  CHECK_EQ(o.str(), "1.000000e-20000");
+}
+
+BOOST_AUTO_TEST_CASE(expsum_stable) {
+  std::vector<double> v;
+  v.push_back(1000.0);
+  v.push_back(1000.0);
+  BOOST_CHECK_CLOSE(expsum(v.begin(), v.end()), 1000.0 + std::log(2.0), 1e-9);
+  v.push_back(-1000.0);
+  BOOST_CHECK_CLOSE(expsum(v.begin(), v.end()), 1000.0 + std::log(2.0), 1e-9);
+  double x[3] = { std::log(1.0), std::log(2.0), std::log(3.0) };
+  BOOST_CHECK_CLOSE(log_sum_exp(x, 3), std::log(6.0), 1e-9);
+  double inf = std::numeric_limits<double>::infinity();
+  double y[2] = { -inf, -inf };
+  CHECK_EQ(log_sum_exp(y, 2), -inf);
+  y[1] = inf;
+  CHECK_EQ(log_sum_exp(y, 2), inf);
+}
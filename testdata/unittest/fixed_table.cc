@@ -0,0 +1,82 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE fixed_table
+#include <boost/test/unit_test.hpp>
+#include "macros.hh"
+
+#include <string>
+
+#include "../../rtlib/fixed_table.hh"
+
+BOOST_AUTO_TEST_CASE(fixed_table_access) {
+  Table::Fixed<int, 16> t;
+  t.resize(10);
+  CHECK_EQ(t.size(), 10u);
+  CHECK(t.is_fixed());
+  for (size_t k = 0; k < t.size(); ++k) {
+    CHECK_EQ(t[k], 0);
+    t[k] = static_cast<int>(k);
+  }
+  const Table::Fixed<int, 16> &c = t;
+  CHECK_EQ(c[7], 7);
+
+  // as std::vector, kept cells keep their values, new ones are reset
+  t.resize(5);
+  t.resize(12);
+  CHECK_EQ(t[4], 4);
+  CHECK_EQ(t[5], 0);
+  CHECK_EQ(t[11], 0);
+
+  t.clear();
+  CHECK_EQ(t.size(), 0u);
+  t.resize(16);
+  CHECK(t.is_fixed());
+  CHECK_EQ(t[3], 0);
+}
+
+BOOST_AUTO_TEST_CASE(fixed_table_overflow) {
+  Table::Fixed<std::string, 4> t;
+  t.resize(3);
+  t[2] = "x";
+  t.resize(100);
+  CHECK(!t.is_fixed());
+  CHECK_EQ(t[2], "x");
+  t[99] = "y";
+
+  Table::Fixed<std::string, 4> u(t);
+  CHECK_EQ(u.size(), 100u);
+  CHECK_EQ(u[99], "y");
+
+  t.resize(4);
+  CHECK(t.is_fixed());
+  CHECK_EQ(t[2], "x");
+  CHECK_EQ(t[3], "");
+
+  u = t;
+  CHECK(u.is_fixed());
+  CHECK_EQ(u.size(), 4u);
+  CHECK_EQ(u[2], "x");
+}
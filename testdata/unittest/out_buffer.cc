@@ -0,0 +1,185 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE out_buffer
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+extern "C" {
+#include <unistd.h>
+}
+
+#include <zlib.h>
+
+#include "macros.hh"
+#include "../../rtlib/output.hh"
+#include "../../rtlib/out_buffer.hh"
+
+template <typename T>
+static void check_put(const T &x,
+                      void (*fmt)(std::ostream&) = 0) {
+  std::ostringstream a, b;
+  if (fmt) {
+    fmt(a);
+    fmt(b);
+  }
+  a << x << '|';
+  gapc::put(b, x) << '|';
+  CHECK_EQ(a.str(), b.str());
+}
+
+static void fixed3(std::ostream &o) {
+  o << std::fixed << std::setprecision(3);
+}
+
+static void sci2(std::ostream &o) {
+  o << std::scientific << std::setprecision(2);
+}
+
+static void prec12(std::ostream &o) {
+  o << std::setprecision(12);
+}
+
+static void hex(std::ostream &o) {
+  o << std::hex << std::showbase;
+}
+
+static void width(std::ostream &o) {
+  o << std::setw(8);
+}
+
+BOOST_AUTO_TEST_CASE(put_numbers) {
+  check_put(0);
+  check_put(-42);
+  check_put(std::numeric_limits<int>::min());
+  check_put(std::numeric_limits<unsigned long long>::max());
+  check_put(static_cast<short>(-7));
+  check_put(0.0);
+  check_put(-0.0);
+  check_put(1.0 / 3);
+  check_put(-1234567.891);
+  check_put(1e-30);
+  check_put(6.02e23f);
+  check_put(std::numeric_limits<double>::infinity());
+  check_put(std::numeric_limits<double>::max());
+  check_put(1.0 / 3, fixed3);
+  check_put(-2.5e-7, fixed3);
+  check_put(123456.789, sci2);
+  check_put(1.0 / 7, prec12);
+  check_put(255, hex);
+  check_put(3.25, width);
+  check_put(7, width);
+}
+
+BOOST_AUTO_TEST_CASE(put_other) {
+  check_put('x');
+  check_put(true);
+  check_put(std::string("foo"));
+  check_put(std::make_pair(1.5, -3));
+  std::ostringstream o;
+  o << std::make_pair(0.25, std::make_pair(2, 'c'));
+  CHECK_EQ(o.str(), "( 0.25 , ( 2 , c ) )");
+}
+
+static std::string read_file(const char *path) {
+  std::FILE *f = std::fopen(path, "rb");
+  std::string r;
+  char buf[4096];
+  size_t n;
+  while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0)
+    r.append(buf, n);
+  std::fclose(f);
+  return r;
+}
+
+BOOST_AUTO_TEST_CASE(buffer) {
+  char path[] = "/tmp/gapc_out_bufferXXXXXX";
+  int fd = mkstemp(path);
+  BOOST_REQUIRE(fd >= 0);
+  std::string big(3 * gapc::Out_Buffer::SIZE / 2, 'a');
+  std::ostringstream expect;
+  {
+    std::ostream o(std::cout.rdbuf());
+    gapc::Out_Redirect r(o, fd, false);
+    for (int i = 0; i < 100000; ++i) {
+      gapc::put(o, i) << ' ';
+      expect << i << ' ';
+    }
+    o << big;
+    expect << big;
+    o.flush();
+    o << "end\n";
+    expect << "end\n";
+  }
+  close(fd);
+  CHECK(read_file(path) == expect.str());
+  std::remove(path);
+}
+
+#ifdef GZIP_OUTPUT
+BOOST_AUTO_TEST_CASE(gzip) {
+  char path[] = "/tmp/gapc_out_bufferXXXXXX";
+  int fd = mkstemp(path);
+  BOOST_REQUIRE(fd >= 0);
+  std::string expect;
+  {
+    std::ostream o(std::cout.rdbuf());
+    gapc::Out_Redirect r(o, fd, true);
+    for (int i = 0; i < 300000; ++i) {
+      o << "( " << i % 97 << " , [] )\n";
+      std::ostringstream s;
+      s << "( " << i % 97 << " , [] )\n";
+      expect += s.str();
+      if (i == 1000)
+        o.flush();
+    }
+  }
+  close(fd);
+  std::string z = read_file(path);
+  std::remove(path);
+  CHECK_LESS(z.size(), expect.size() / 10);
+
+  std::string got(expect.size() + 1, 0);
+  z_stream s;
+  std::memset(&s, 0, sizeof(s));
+  BOOST_REQUIRE(inflateInit2(&s, 15 + 16) == Z_OK);
+  s.next_in = reinterpret_cast<Bytef*>(&z[0]);
+  s.avail_in = z.size();
+  s.next_out = reinterpret_cast<Bytef*>(&got[0]);
+  s.avail_out = got.size();
+  CHECK_EQ(inflate(&s, Z_FINISH), Z_STREAM_END);
+  got.resize(got.size() - s.avail_out);
+  inflateEnd(&s);
+  CHECK(got == expect);
+}
+#endif
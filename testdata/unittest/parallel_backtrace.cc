@@ -0,0 +1,98 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE parallel_backtrace
+#include <boost/test/unit_test.hpp>
+#include "macros.hh"
+
+#include <sstream>
+#include <string>
+
+#include "../../rtlib/parallel_backtrace.hh"
+
+static std::string run(unsigned repeats, unsigned jobs) {
+  std::ostringstream o;
+  unsigned calls = 0;
+  gapc::parallel_backtrace(o, repeats, jobs,
+    [&calls](std::ostream &out, unsigned n) {
+      for (unsigned i = 0; i < n; ++i)
+        out << getpid() << ' ' << calls++ << '\n';
+    });
+  return o.str();
+}
+
+static size_t lines(const std::string &s) {
+  size_t r = 0;
+  for (size_t i = 0; i < s.size(); ++i)
+    r += s[i] == '\n';
+  return r;
+}
+
+BOOST_AUTO_TEST_CASE(serial) {
+  std::ostringstream pid;
+  pid << getpid() << ' ';
+  std::string s = run(3, 1);
+  CHECK_EQ(lines(s), 3u);
+  CHECK_EQ(s.find(pid.str()), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(workers) {
+  for (unsigned jobs = 2; jobs < 6; ++jobs) {
+    std::string s = run(10, jobs);
+    CHECK_EQ(lines(s), 10u);
+    // every worker starts counting in its own copy of the state, the
+    // chunks are printed in worker order
+    std::istringstream in(s);
+    long last_pid = 0;
+    unsigned chunks = 0, expect = 0;
+    long p;
+    unsigned c;
+    while (in >> p >> c) {
+      if (p != last_pid) {
+        ++chunks;
+        expect = 0;
+        last_pid = p;
+      }
+      CHECK_EQ(c, expect);
+      ++expect;
+    }
+    CHECK_EQ(chunks, jobs);
+  }
+  // at most one worker per repeat
+  CHECK_EQ(lines(run(2, 8)), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(failing_worker) {
+  std::ostringstream o;
+  bool thrown = false;
+  try {
+    gapc::parallel_backtrace(o, 4, 2, [](std::ostream &out, unsigned n) {
+      throw std::runtime_error("backtrace failed");
+    });
+  } catch (std::runtime_error &e) {
+    thrown = true;
+  }
+  CHECK(thrown);
+}
@@ -0,0 +1,84 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE pass_report
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include "macros.hh"
+
+#include "../../src/pass_report.hh"
+
+BOOST_AUTO_TEST_CASE(pass_report_disabled) {
+  Pass_Report r;
+  r.begin("front");
+  r.end();
+  CHECK(!r.enabled());
+  CHECK(r.passes().empty());
+  std::ostringstream o;
+  r.print(o);
+  CHECK(o.str().empty());
+}
+
+BOOST_AUTO_TEST_CASE(pass_report_nesting) {
+  Pass_Report r;
+  r.enable(true, true);
+  {
+    Pass_Report::Scope front(r, "front");
+    r.begin("parse");
+    r.end();
+    // 64 MiB, touched such that they are resident
+    std::vector<char> v;
+    r.begin("table_design");
+    v.resize(64 << 20);
+    std::memset(v.data(), 1, v.size());
+    r.end();
+  }
+  r.begin("back");
+  r.end();
+
+  const std::vector<Pass_Report::Entry> &e = r.passes();
+  CHECK_EQ(e.size(), 4u);
+  CHECK_EQ(e[0].name, "front");
+  CHECK_EQ(e[0].depth, 0u);
+  CHECK_EQ(e[1].name, "parse");
+  CHECK_EQ(e[1].depth, 1u);
+  CHECK_EQ(e[2].name, "table_design");
+  CHECK_EQ(e[2].depth, 1u);
+  CHECK(e[2].delta >= 60 << 10);
+  CHECK(e[2].peak >= e[2].rss);
+  CHECK_EQ(e[3].name, "back");
+  CHECK_EQ(e[3].depth, 0u);
+  CHECK(e[0].wall >= e[1].wall + e[2].wall);
+
+  std::ostringstream o;
+  r.print(o);
+  CHECK(o.str().find("pass execution times") != std::string::npos);
+  CHECK(o.str().find("pass memory usage") != std::string::npos);
+  CHECK(o.str().find("    table_design\n") != std::string::npos);
+}
@@ -0,0 +1,127 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE row_table
+#include <boost/test/unit_test.hpp>
+#include "macros.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../../rtlib/row_table.hh"
+
+// two tables of 3 cells per row, whose rows depend on the next 2 rows,
+// as the generated cyk_rows()
+struct Rows_Prog {
+  Table::Row_Blocks blocks;
+  Table::Rows<uint64_t> a, b;
+  size_t rows;
+  size_t computed;
+
+  uint64_t get(Table::Rows<uint64_t> &t, size_t r, size_t c) {
+    return r < rows ? t[r * 3 + c] : 1;
+  }
+
+  void cyk_rows(size_t hi, size_t lo) {
+    for (size_t r = hi + 1; r > lo; --r) {
+      size_t i = r - 1;
+      for (size_t c = 0; c < 3; ++c) {
+        a[i * 3 + c] = get(a, i + 1, c) + get(b, i + 2, (c + 1) % 3) + c;
+        b[i * 3 + c] = get(a, i, c) * 3 + get(b, i + 1, c);
+      }
+      ++computed;
+    }
+  }
+
+  void init(size_t n, size_t depth, size_t block_rows) {
+    rows = n;
+    computed = 0;
+    blocks.init(rows, depth,
+                [this](size_t hi, size_t lo) { cyk_rows(hi, lo); },
+                block_rows);
+    a.init(blocks, rows * 3);
+    b.init(blocks, rows * 3);
+    cyk_rows(rows - 1, 0);
+  }
+};
+
+static void reference(size_t rows, std::vector<uint64_t> &a,
+                      std::vector<uint64_t> &b) {
+  a.assign(rows * 3 + 6, 1);
+  b.assign(rows * 3 + 6, 1);
+  for (size_t r = rows; r > 0; --r) {
+    size_t i = r - 1;
+    for (size_t c = 0; c < 3; ++c) {
+      a[i * 3 + c] = a[(i + 1) * 3 + c] + b[(i + 2) * 3 + (c + 1) % 3] + c;
+      b[i * 3 + c] = a[i * 3 + c] * 3 + b[(i + 1) * 3 + c];
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(row_table_backtrace) {
+  Rows_Prog p;
+  p.init(50, 2, 0);
+  CHECK_EQ(p.blocks.block_rows(), 10u);
+  CHECK_EQ(p.computed, 50u);
+  CHECK(p.a.resident() < p.a.size());
+
+  std::vector<uint64_t> a, b;
+  reference(50, a, b);
+  // a backtrace reads the rows in ascending order, each evicted block is
+  // recomputed once
+  for (size_t off = 0; off < 150; ++off) {
+    CHECK_EQ(p.a[off], a[off]);
+    CHECK_EQ(p.b[off], b[off]);
+  }
+  CHECK_EQ(p.computed, 80u);
+
+  std::vector<size_t> offs(150);
+  for (size_t k = 0; k < offs.size(); ++k)
+    offs[k] = k;
+  std::shuffle(offs.begin(), offs.end(), std::mt19937(42));
+  for (size_t k = 0; k < offs.size(); ++k) {
+    CHECK_EQ(p.a[offs[k]], a[offs[k]]);
+    CHECK_EQ(p.b[offs[k]], b[offs[k]]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(row_table_depth) {
+  Rows_Prog p;
+  // too few checkpointed rows for a recomputation
+  p.init(50, 1, 4);
+  std::vector<uint64_t> a, b;
+  reference(50, a, b);
+  CHECK_EQ(p.a[0], a[0]);
+  BOOST_CHECK_THROW(p.a[41 * 3], std::logic_error);
+
+  // a new instance with the same tables
+  p.init(20, 2, 4);
+  reference(20, a, b);
+  CHECK_EQ(p.b[19 * 3 + 2], b[19 * 3 + 2]);
+  CHECK_EQ(p.a[9 * 3 + 1], a[9 * 3 + 1]);
+}
@@ -49,6 +49,62 @@ BOOST_AUTO_TEST_CASE(copier) {
   CHECK_EQ(s[2], 0.4);
 }
 
+BOOST_AUTO_TEST_CASE(copier_numbers) {
+  const char *t = " 1e-3\t+2.5\n0x1p3 -inf 7x 1e400 5";
+  Basic_Sequence<double> d;
+  d.copy(t, strlen(t));
+  // stops at the out of range value
+  CHECK_EQ(d.size(), 5);
+  CHECK_EQ(d[0], 1e-3);
+  CHECK_EQ(d[1], 2.5);
+  CHECK_EQ(d[2], 8.0);
+  CHECK_EQ(d[3], -std::numeric_limits<double>::infinity());
+  CHECK_EQ(d[4], 7.0);
+
+  Basic_Sequence<float> f;
+  const char *u = "0.1 3 ";
+  f.copy(u, strlen(u));
+  CHECK_EQ(f.size(), 2);
+  CHECK_EQ(f[0], static_cast<float>(0.1));
+  CHECK_EQ(f[1], 3.0f);
+
+  Basic_Sequence<int> i;
+  const char *v = "-12 +3 0x1f 017 0 -0 2147483647";
+  i.copy(v, strlen(v));
+  CHECK_EQ(i.size(), 7);
+  CHECK_EQ(i[0], -12);
+  CHECK_EQ(i[1], 3);
+  CHECK_EQ(i[2], 31);
+  CHECK_EQ(i[3], 15);
+  CHECK_EQ(i[4], 0);
+  CHECK_EQ(i[5], 0);
+  CHECK_EQ(i[6], 2147483647);
+
+  const char *w = "1 99999999999999999999";
+  BOOST_CHECK_THROW(i.copy(w, strlen(w)), std::runtime_error);
+  BOOST_CHECK_THROW(i.copy("  ", 2), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(copier_binary) {
+  const unsigned char le[] = {0, 0, 0xc0, 0x3f, 0, 0, 0x20, 0xc1};
+  Basic_Sequence<float> f;
+  f.copy_binary(reinterpret_cast<const char*>(le), sizeof(le));
+  CHECK_EQ(f.size(), 2);
+  CHECK_EQ(f[0], 1.5f);
+  CHECK_EQ(f[1], -10.0f);
+
+  Basic_Sequence<int> i;
+  i.copy_binary(reinterpret_cast<const char*>(le), sizeof(le));
+  CHECK_EQ(i.size(), 2);
+  CHECK_EQ(i[0], 0x3fc00000);
+
+  Basic_Sequence<double> d;
+  d.copy_binary(reinterpret_cast<const char*>(le), sizeof(le));
+  CHECK_EQ(d.size(), 1);
+  BOOST_CHECK_THROW(d.copy_binary(reinterpret_cast<const char*>(le), 4),
+                    std::length_error);
+}
+
 #include "../../rtlib/terminal.hh"
 
 BOOST_AUTO_TEST_CASE(sepp) {
@@ -173,3 +229,26 @@ BOOST_AUTO_TEST_CASE(seq_upper) {
   CHECK_EQ(x, "FOOBARBAZ");
 }
 
+
+BOOST_AUTO_TEST_CASE(numeric_terminals) {
+  Sequence s;
+  const char inp[] = "12.50x0042.1.5 99999999999";
+  s.copy(inp, strlen(inp));
+  CHECK_EQ(INT(s, 0u, 2u), 12);
+  CHECK(isEmpty(INT(s, 0u, 3u)));
+  CHECK_EQ(INT(s, 6u, 10u), 42);
+  CHECK_EQ(INT(s, 9u, 10u), 2);
+  CHECK(isEmpty(INT(s, 4u, 6u)));
+
+  CHECK_EQ(FLOAT(s, 0u, 5u), 12.5f);
+  CHECK_EQ(FLOAT(s, 3u, 5u), 50.0f);
+  CHECK(isEmpty(FLOAT(s, 0u, 6u)));
+  // digits right of the first '.' count for the exponent
+  CHECK_EQ(FLOAT(s, 6u, 14u), static_cast<float>(4215.0f / 1e2));
+  CHECK_EQ(FLOAT(s, 10u, 11u), 0.0f);
+  // beyond 2^24 the digits are combined one by one
+  float big = 0;
+  for (int k = 0; k < 11; ++k)
+    big = big * 10 + 9;
+  CHECK_EQ(FLOAT(s, 15u, 26u), big);
+}
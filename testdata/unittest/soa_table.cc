@@ -0,0 +1,70 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE soa_table
+#include <boost/test/unit_test.hpp>
+#include "macros.hh"
+
+#include <utility>
+
+#include "../../rtlib/soa_table.hh"
+
+BOOST_AUTO_TEST_CASE(soa_table_access) {
+  Table::SoA<std::pair<int, double> > t;
+  t.resize(1000);
+  CHECK_EQ(t.size(), 1000u);
+  for (size_t k = 0; k < t.size(); ++k) {
+    t[k] = std::make_pair(static_cast<int>(k), k * 0.5);
+  }
+  std::pair<int, double> x = t[42];
+  CHECK_EQ(x.first, 42);
+  CHECK_EQ(x.second, 21.0);
+
+  t[42] = std::make_pair(-1, 2.5);
+  const Table::SoA<std::pair<int, double> > &c = t;
+  CHECK_EQ(c[42].first, -1);
+  CHECK_EQ(c[42].second, 2.5);
+  CHECK_EQ(c[43].first, 43);
+
+  t.clear();
+  CHECK_EQ(t.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(soa_table_bool) {
+  Table::SoA<std::pair<bool, int> > t;
+  t.resize(64);
+  for (size_t k = 0; k < t.size(); ++k) {
+    t[k] = std::make_pair(k % 3 == 0, static_cast<int>(k));
+  }
+  const Table::SoA<std::pair<bool, int> > &c = t;
+  for (size_t k = 0; k < c.size(); ++k) {
+    CHECK_EQ(c[k].first, k % 3 == 0);
+    CHECK_EQ(c[k].second, static_cast<int>(k));
+  }
+  std::pair<bool, int> x = t[3];
+  CHECK(x.first);
+  t[3] = std::make_pair(false, 7);
+  CHECK(!c[3].first);
+}
@@ -0,0 +1,74 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE sparse_table
+#include <boost/test/unit_test.hpp>
+#include "macros.hh"
+
+#include <vector>
+
+#include "../../rtlib/sparse_table.hh"
+
+BOOST_AUTO_TEST_CASE(sparse_table_access) {
+  Table::Sparse<int> t;
+  t.resize(100000);
+  CHECK_EQ(t.size(), 100000u);
+  CHECK(!t.contains(42));
+  t[42] = 23;
+  CHECK(t.contains(42));
+  CHECK_EQ(t[42], 23);
+  CHECK_EQ(t.count(), 1u);
+
+  t.resize(10);
+  CHECK(!t.contains(4));
+  CHECK_EQ(t.count(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(sparse_table_stable_refs) {
+  Table::Sparse<int> t;
+  size_t n = 500 * 501 / 2;
+  t.resize(n);
+  int &first = t[0];
+  first = -1;
+  std::vector<size_t> keys;
+  // a band of width 5 of a quadratic table with offset j*(j+1)/2 + i
+  for (size_t j = 0; j < 500; ++j) {
+    for (size_t i = j > 5 ? j - 5 : 0; i <= j; ++i) {
+      size_t k = j * (j + 1) / 2 + i;
+      t[k] = static_cast<int>(i + j);
+      keys.push_back(k);
+    }
+  }
+  CHECK_EQ(t.count(), keys.size());
+  // growing the index must not move the values
+  CHECK_EQ(first, 0);
+  for (size_t j = 0; j < 500; ++j) {
+    for (size_t i = j > 5 ? j - 5 : 0; i <= j; ++i) {
+      CHECK_EQ(t[j * (j + 1) / 2 + i], static_cast<int>(i + j));
+    }
+  }
+  CHECK(!t.contains(499 * 500 / 2));
+  CHECK(t.bytes() < n * sizeof(int));
+}
@@ -0,0 +1,121 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE split_reduce
+#include <boost/test/unit_test.hpp>
+#include "macros.hh"
+
+#include <cstdlib>
+#include <vector>
+
+#include "../../rtlib/split_reduce.hh"
+
+// what the generated code computes without the fused reduction, i.e. a
+// push_back_min/max of every candidate with non-empty operands
+template<typename T>
+static T naive(const std::vector<T> &a, const std::vector<T> &b, size_t k,
+               size_t end, bool max) {
+  T r;
+  empty(r);
+  for (; k < end; ++k) {
+    if (isEmpty(a[k]) || isEmpty(b[k])) {
+      continue;
+    }
+    T v = a[k] + b[k];
+    if (isEmpty(r) || (max ? r < v : v < r)) {
+      r = v;
+    }
+  }
+  return r;
+}
+
+template<typename T>
+static void fill(std::vector<T> &v, size_t n, int empty_percent) {
+  v.resize(n);
+  for (size_t k = 0; k < n; ++k) {
+    if (std::rand() % 100 < empty_percent) {
+      empty(v[k]);
+    } else {
+      v[k] = static_cast<T>(std::rand() % 2001 - 1000);
+    }
+  }
+}
+
+template<typename T>
+static void check_random() {
+  std::srand(42);
+  for (int empty_percent = 0; empty_percent <= 100; empty_percent += 25) {
+    for (size_t n = 0; n < 40; ++n) {
+      std::vector<T> a, b;
+      fill(a, n, empty_percent);
+      fill(b, n, empty_percent);
+      for (size_t k = 0; k <= n; k += 3) {
+        CHECK_EQ(split_min_plus(a.data(), b.data(), k, n),
+                 naive(a, b, k, n, false));
+        CHECK_EQ(split_max_plus(a.data(), b.data(), k, n),
+                 naive(a, b, k, n, true));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(split_reduce_int) {
+  check_random<int>();
+}
+
+BOOST_AUTO_TEST_CASE(split_reduce_float) {
+  check_random<float>();
+}
+
+BOOST_AUTO_TEST_CASE(split_reduce_double) {
+  check_random<double>();
+}
+
+BOOST_AUTO_TEST_CASE(split_reduce_empty) {
+  std::vector<int> a(9), b(9);
+  for (size_t k = 0; k < a.size(); ++k) {
+    a[k] = static_cast<int>(k);
+    empty(b[k]);
+  }
+  // the sum with an empty operand must not wrap around to a minimum
+  CHECK(isEmpty(split_min_plus(a.data(), b.data(), 0, 9)));
+  CHECK(isEmpty(split_max_plus(a.data(), b.data(), 0, 9)));
+  CHECK(isEmpty(split_min_plus(a.data(), b.data(), 4, 4)));
+
+  b[7] = -5;
+  CHECK_EQ(split_min_plus(a.data(), b.data(), 0, 9), 2);
+  CHECK_EQ(split_max_plus(a.data(), b.data(), 0, 9), 2);
+  CHECK(isEmpty(split_max_plus(a.data(), b.data(), 0, 7)));
+
+  // negative candidates in a reduction, which finds one in the vector
+  // lanes only
+  std::vector<float> x(8, -3.5f), y(8);
+  for (size_t k = 0; k < y.size(); ++k) {
+    empty(y[k]);
+  }
+  y[1] = -1;
+  CHECK_EQ(split_max_plus(x.data(), y.data(), 0, 8), -4.5f);
+  CHECK_EQ(split_min_plus(x.data(), y.data(), 0, 8), -4.5f);
+}
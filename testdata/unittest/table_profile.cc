@@ -0,0 +1,79 @@
+/* {{{
+
+    This file is part of gapc (GAPC - Grammars, Algebras, Products - Compiler;
+      a system to compile algebraic dynamic programming programs)
+
+    Copyright (C) 2011-2023  Stefan Janssen
+         email: stefan.m.janssen@gmail.com or stefan.janssen@computational.bio.uni-giessen.de
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+}}} */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE table_profile
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+#include "macros.hh"
+
+#include "../../src/table_profile.hh"
+#include "../../src/log.hh"
+
+BOOST_AUTO_TEST_CASE(table_profile_read) {
+  std::istringstream in(
+    "# gapc table profile\n"
+    "n 100\n"
+    "\n"
+    "nt struct gets 5151 hits 101 sets 5050 cells 5151 bytes 41208\n"
+    "nt hairpin gets 200 hits 0 sets 200 cells 5151 bytes 20604\n");
+  Table_Profile p;
+  p.read(in, "in");
+  CHECK_EQ(p.n, 100u);
+  CHECK_EQ(p.nts.size(), 2u);
+  const Table_Profile::Entry *e = p.find("struct");
+  CHECK(e);
+  CHECK_EQ(e->hits, 101u);
+  CHECK_EQ(e->bytes, 41208u);
+  e = p.find("hairpin");
+  CHECK(e);
+  CHECK_EQ(e->hits, 0u);
+  CHECK(e->fill() < 0.05);
+  CHECK(!p.find("foo"));
+}
+
+BOOST_AUTO_TEST_CASE(table_profile_cyk) {
+  // in cyk code every cell is computed once by the fill loops and all
+  // calls of the non-terminal are answered from the table, i.e. hits are
+  // not gets - sets
+  std::istringstream in(
+    "n 100\n"
+    "nt struct gets 171700 hits 171700 sets 5151 cells 5151 bytes 20604\n");
+  Table_Profile p;
+  p.read(in, "in");
+  const Table_Profile::Entry *e = p.find("struct");
+  CHECK(e);
+  CHECK_EQ(e->hits, 171700u);
+  CHECK_EQ(e->sets, 5151u);
+}
+
+BOOST_AUTO_TEST_CASE(table_profile_malformed) {
+  std::istringstream in("nt struct gets 10 sets\n");
+  Table_Profile p;
+  BOOST_CHECK_THROW(p.read(in, "in"), LogError);
+  std::istringstream old("nt struct gets 10 sets 5 cells 10 bytes 40\n");
+  BOOST_CHECK_THROW(p.read(old, "old"), LogError);
+}
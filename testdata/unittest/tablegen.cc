@@ -33,6 +33,7 @@
 // #define BOOST_TEST_MAIN
 // #include <boost/test/included/unit_test_framework.hpp>
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <string>
@@ -281,6 +282,108 @@ BOOST_AUTO_TEST_CASE(right_lin) {
   */
 }
 
+BOOST_AUTO_TEST_CASE(right_lin_band) {
+  std::vector<Table> v;
+  Table t;
+  t |= Table::LINEAR;
+  t.set_sticky(Table::RIGHT);
+  t.set_right_rest(Yield::Size(Yield::Poly(0), Yield::Poly(2)));
+  v.push_back(t);
+
+  Table u;
+  u |= Table::LINEAR;
+  u.set_sticky(Table::RIGHT);
+  u.set_right_rest(Yield::Size(Yield::Poly(0), Yield::Poly(1)));
+  v.push_back(u);
+
+  Tablegen tg;
+  tg.set_band(true);
+
+  tg.offset(0, v.begin(), v.end());
+
+  // only the cells with |t_0_i - t_1_i| <= band are stored
+  set_t m;
+  for (int c = 0; c < 3; ++c)
+    for (int d = 0; d < 2; ++d)
+  for (int a = 0; a < 13; ++a)
+    for (int b = std::max(0, a - 3); b < 23 && b <= a + 3; ++b) {
+      env_t e;
+      e["t_0_i"] = a;
+      e["t_1_i"] = b;
+      e["t_0_real_j"] = c;
+      e["t_1_real_j"] = d;
+      e["t_0_n"] = 12;
+      e["t_1_n"] = 22;
+      e["band"] = 3;
+      int r = parse(tg.off, e);
+      set_t::iterator x = m.find(r);
+      CHECK(x == m.end());
+      m.insert(r);
+
+      if (c == 2 && d == 1 && a == 12 && b == 15)
+        CHECK_EQ(r, 545);
+      if (c == 0 && d == 0 && a == 0 && b == 0)
+        CHECK_EQ(r, 3);
+    }
+
+  env_t e;
+  e["t_0_n"] = 12;
+  e["t_1_n"] = 22;
+  e["band"] = 3;
+  int s = parse(tg.size, e);
+  CHECK_EQ(s, 546);
+}
+
+BOOST_AUTO_TEST_CASE(right_lin_rows) {
+  std::vector<Table> v;
+  Table t;
+  t |= Table::LINEAR;
+  t.set_sticky(Table::RIGHT);
+  t.set_right_rest(Yield::Size(Yield::Poly(0), Yield::Poly(2)));
+  v.push_back(t);
+
+  Table u;
+  u |= Table::LINEAR;
+  u.set_sticky(Table::RIGHT);
+  u.set_right_rest(Yield::Size(Yield::Poly(0), Yield::Poly(1)));
+  v.push_back(u);
+
+  Tablegen tg;
+  tg.set_rows(true);
+
+  tg.offset(0, v.begin(), v.end());
+
+  // the cells of each t_0_i are one contiguous block of 3 * 23 * 2 cells
+  set_t m;
+  for (int c = 0; c < 3; ++c)
+    for (int d = 0; d < 2; ++d)
+  for (int a = 0; a < 13; ++a)
+    for (int b = 0; b < 23; ++b) {
+      env_t e;
+      e["t_0_i"] = a;
+      e["t_1_i"] = b;
+      e["t_0_real_j"] = c;
+      e["t_1_real_j"] = d;
+      e["t_0_n"] = 12;
+      e["t_1_n"] = 22;
+      int r = parse(tg.off, e);
+      set_t::iterator x = m.find(r);
+      CHECK(x == m.end());
+      m.insert(r);
+      CHECK(r >= a * 138);
+      CHECK(r < (a + 1) * 138);
+
+      if (c == 2 && d == 1 && a == 12 && b == 22)
+        CHECK_EQ(r, 1793);
+    }
+
+  env_t e;
+  e["t_0_n"] = 12;
+  e["t_1_n"] = 22;
+  int s = parse(tg.size, e);
+  CHECK_EQ(s, 1794);
+}
+
 BOOST_AUTO_TEST_CASE(right_lin2) {
   std::vector<Table> v;
   Table t;
@@ -465,3 +568,40 @@ BOOST_AUTO_TEST_CASE(mixed) {
   int s = parse(tg.size, e);
   CHECK_EQ(s, 728);
 }
+
+BOOST_AUTO_TEST_CASE(fixed_cells) {
+  Table quad;
+  quad |= Table::QUADRATIC;
+  Table left;
+  left |= Table::LINEAR;
+  left.set_sticky(Table::LEFT);
+  Table right;
+  right |= Table::LINEAR;
+  right.set_sticky(Table::RIGHT);
+  right.set_right_rest(Yield::Size(Yield::Poly(0), Yield::Poly(2)));
+  Table cons;
+  cons |= Table::CONSTANT;
+  cons.set_left_rest(Yield::Size(Yield::Poly(0), Yield::Poly(2)));
+  cons.set_right_rest(Yield::Size(Yield::Poly(0), Yield::Poly(3)));
+
+  std::vector<std::vector<Table> > dims;
+  dims.push_back(std::vector<Table>(1, quad));
+  dims.push_back(std::vector<Table>(1, left));
+  dims.push_back(std::vector<Table>(1, cons));
+  std::vector<Table> v;
+  v.push_back(quad);
+  v.push_back(right);
+  dims.push_back(v);
+
+  for (size_t k = 0; k < dims.size(); ++k) {
+    Tablegen tg;
+    tg.offset(0, dims[k].begin(), dims[k].end());
+    for (int n = 0; n < 20; ++n) {
+      env_t e;
+      e["t_0_n"] = n;
+      e["t_1_n"] = n;
+      CHECK_EQ(static_cast<int>(Tablegen::cells(dims[k], n)),
+               parse(tg.size, e));
+    }
+  }
+}